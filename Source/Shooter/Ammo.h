@@ -16,8 +16,6 @@ class SHOOTER_API AAmmo : public AItem
 	GENERATED_BODY()
 public:
 	AAmmo();
-	
-	virtual void Tick(float DeltaTime) override;
 
 protected:
 	virtual void BeginPlay() override;
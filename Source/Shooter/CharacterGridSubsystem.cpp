@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CharacterGridSubsystem.h"
+#include "GameFramework/Character.h"
+#include "Components/CapsuleComponent.h"
+
+void UCharacterGridSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	for (ACharacter* Character : Characters)
+	{
+		if (IsValid(Character))
+		{
+			Grid.Update(Character, Character->GetActorLocation());
+		}
+	}
+}
+
+TStatId UCharacterGridSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCharacterGridSubsystem, STATGROUP_Tickables);
+}
+
+bool UCharacterGridSubsystem::IsTickable() const
+{
+	return Characters.Num() > 0;
+}
+
+bool UCharacterGridSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCharacterGridSubsystem::RegisterCharacter(ACharacter* Character)
+{
+	if (Character == nullptr || Grid.Contains(Character)) return;
+
+	Characters.Add(Character);
+	Grid.Add(Character, Character->GetActorLocation());
+	MaxCapsuleRadius = FMath::Max(MaxCapsuleRadius, Character->GetCapsuleComponent()->GetScaledCapsuleRadius());
+}
+
+void UCharacterGridSubsystem::UnregisterCharacter(ACharacter* Character)
+{
+	if (!Grid.Contains(Character)) return;
+
+	Characters.RemoveSingleSwap(Character, false);
+	Grid.Remove(Character);
+}
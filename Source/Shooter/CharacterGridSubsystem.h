@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SpatialHashGrid.h"
+#include "CharacterGridSubsystem.generated.h"
+
+class ACharacter;
+
+/**
+ * Spatial hash of every player character and enemy in the world, for area queries
+ * (explosions, AI awareness) that would otherwise need overlap events or a physics overlap.
+ * Registered characters have their grid location refreshed once per frame.
+ */
+UCLASS()
+class SHOOTER_API UCharacterGridSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override;
+
+	void RegisterCharacter(ACharacter* Character);
+	void UnregisterCharacter(ACharacter* Character);
+
+	/** Append every registered character whose location is within Radius of Center */
+	template<typename AllocatorType>
+	void QueryCharacters(const FVector& Center, float Radius, TArray<ACharacter*, AllocatorType>& OutCharacters) const
+	{
+		Grid.QuerySphere(Center, Radius, OutCharacters);
+	}
+
+	/** Largest capsule radius of any character registered so far; pad queries by it to find capsules reaching into a sphere */
+	FORCEINLINE float GetMaxCapsuleRadius() const { return MaxCapsuleRadius; }
+
+	/** Grid cell size, in cm */
+	static constexpr float CellSize{ 1'000.f };
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	UPROPERTY()
+	TArray<ACharacter*> Characters;
+
+	TSpatialHashGrid<ACharacter*> Grid{ CellSize };
+
+	float MaxCapsuleRadius{ 0.f };
+};
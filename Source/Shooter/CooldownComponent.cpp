@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CooldownComponent.h"
+
+UCooldownComponent::UCooldownComponent()
+{
+	// Only ticks while a cooldown with an expiry callback is running
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void UCooldownComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	const double Now{ GetWorldTime() };
+	for (int32 Slot = 0; Slot < ExpiryTimes.Num(); Slot++)
+	{
+		if (ExpiryTimes[Slot] <= 0.0 || ExpiryTimes[Slot] > Now || !ExpiryCallbacks[Slot].IsBound()) continue;
+
+		// Cleared before the callback, which may start it again
+		ExpiryTimes[Slot] = 0.0;
+		NumPendingCallbacks--;
+		ExpiryCallbacks[Slot].Execute();
+	}
+
+	if (NumPendingCallbacks == 0)
+	{
+		SetComponentTickEnabled(false);
+	}
+}
+
+int32 UCooldownComponent::AddCooldown(FSimpleDelegate OnExpired)
+{
+	ExpiryTimes.Add(0.0);
+	return ExpiryCallbacks.Add(MoveTemp(OnExpired));
+}
+
+void UCooldownComponent::StartCooldown(int32 Slot, float Duration)
+{
+	check(ExpiryTimes.IsValidIndex(Slot));
+
+	// Same as FTimerManager: a non-positive duration clears the timer
+	if (Duration <= 0.f)
+	{
+		ClearCooldown(Slot);
+		return;
+	}
+
+	if (ExpiryCallbacks[Slot].IsBound() && ExpiryTimes[Slot] <= 0.0)
+	{
+		NumPendingCallbacks++;
+		SetComponentTickEnabled(true);
+	}
+	ExpiryTimes[Slot] = GetWorldTime() + Duration;
+}
+
+void UCooldownComponent::ClearCooldown(int32 Slot)
+{
+	check(ExpiryTimes.IsValidIndex(Slot));
+
+	if (ExpiryCallbacks[Slot].IsBound() && ExpiryTimes[Slot] > 0.0)
+	{
+		NumPendingCallbacks--;
+	}
+	ExpiryTimes[Slot] = 0.0;
+}
+
+bool UCooldownComponent::IsCoolingDown(int32 Slot) const
+{
+	return ExpiryTimes.IsValidIndex(Slot) && ExpiryTimes[Slot] > GetWorldTime();
+}
+
+float UCooldownComponent::GetRemainingTime(int32 Slot) const
+{
+	if (!ExpiryTimes.IsValidIndex(Slot)) return 0.f;
+
+	return static_cast<float>(FMath::Max(ExpiryTimes[Slot] - GetWorldTime(), 0.0));
+}
+
+double UCooldownComponent::GetWorldTime() const
+{
+	const UWorld* World{ GetWorld() };
+	return World ? World->GetTimeSeconds() : 0.0;
+}
@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "CooldownComponent.generated.h"
+
+/**
+ * Flat table of cooldowns for one actor, replacing timer-manager entries that only flip a state back.
+ * Each cooldown is an expiry timestamp: re-arming overwrites it and checking it compares against
+ * world time. Cooldowns with an expiry callback are checked in a single pass per tick, and the
+ * component only ticks while one of those is pending.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class SHOOTER_API UCooldownComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UCooldownComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** Add a cooldown slot, optionally with a callback for when it expires. Returns the slot */
+	int32 AddCooldown(FSimpleDelegate OnExpired = FSimpleDelegate());
+
+	/** (Re)start the cooldown so it expires Duration seconds from now */
+	void StartCooldown(int32 Slot, float Duration);
+
+	/** End the cooldown now without calling its expiry callback */
+	void ClearCooldown(int32 Slot);
+
+	bool IsCoolingDown(int32 Slot) const;
+
+	/** Seconds until the cooldown expires; 0 if it isn't running */
+	float GetRemainingTime(int32 Slot) const;
+
+private:
+	double GetWorldTime() const;
+
+	/** World time each slot expires at; 0 when not running */
+	TArray<double> ExpiryTimes;
+
+	/** Called once when a slot expires, if bound */
+	TArray<FSimpleDelegate> ExpiryCallbacks;
+
+	/** Running slots that have an expiry callback */
+	int32 NumPendingCallbacks{ 0 };
+};
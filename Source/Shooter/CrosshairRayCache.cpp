@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CrosshairRayCache.h"
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "ShooterStats.h"
+
+bool FCrosshairRayCache::GetRay(APlayerController* PlayerController, FVector& OutStart, FVector& OutEnd)
+{
+	if (RayFrame != GFrameCounter)
+	{
+		RayFrame = GFrameCounter;
+
+		//Get Viewport size
+		FVector2D ViewportSize;
+		if (GEngine && GEngine->GameViewport)
+		{
+			GEngine->GameViewport->GetViewportSize(ViewportSize);
+		}
+
+		// Get Screen space location of crosshairs
+		FVector2D CrosshairLocation(ViewportSize.X / 2.f, ViewportSize.Y / 2.f);
+		FVector CrosshairWorldPosition;
+		FVector CrosshairWorldDirection;
+
+		// Get world posiition and direction of crosshairs
+		bRayValid = UGameplayStatics::DeprojectScreenToWorld(
+			PlayerController,
+			CrosshairLocation,
+			CrosshairWorldPosition,
+			CrosshairWorldDirection);
+
+		if (bRayValid)
+		{
+			RayStart = CrosshairWorldPosition;
+			RayEnd = CrosshairWorldPosition + CrosshairWorldDirection * TraceDistance;
+		}
+	}
+
+	if (bRayValid)
+	{
+		OutStart = RayStart;
+		OutEnd = RayEnd;
+	}
+	return bRayValid;
+}
+
+bool FCrosshairRayCache::GetHit(APlayerController* PlayerController, FHitResult& OutHitResult, FVector& OutHitLocation)
+{
+	if (HitFrame != GFrameCounter)
+	{
+		HitFrame = GFrameCounter;
+		bHit = false;
+		HitResult = FHitResult();
+
+		FVector Start;
+		FVector End;
+		if (PlayerController && GetRay(PlayerController, Start, End))
+		{
+			//Trace from crosshair world location outward
+			HitLocation = End;
+			SHOOTER_COUNT_TRACE();
+			PlayerController->GetWorld()->LineTraceSingleByChannel(
+				HitResult,
+				Start,
+				End,
+				ECollisionChannel::ECC_Visibility);
+			if (HitResult.bBlockingHit)
+			{
+				HitLocation = HitResult.Location;
+				bHit = true;
+			}
+		}
+	}
+
+	OutHitResult = HitResult;
+	OutHitLocation = HitLocation;
+	return bHit;
+}
+
+bool FCrosshairRayCache::GetCachedHitLocation(FVector& OutHitLocation) const
+{
+	if (HitFrame != GFrameCounter || !bRayValid) return false;
+
+	OutHitLocation = HitLocation;
+	return true;
+}
+
+void FCrosshairRayCache::Invalidate()
+{
+	RayFrame = MAX_uint64;
+	HitFrame = MAX_uint64;
+}
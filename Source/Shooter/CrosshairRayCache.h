@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/HitResult.h"
+
+class APlayerController;
+
+/**
+ * Crosshair deprojection and visibility hit for one player, computed at most once per frame.
+ * Firing, item tracing and beam end points all read from the same cached ray.
+ */
+struct FCrosshairRayCache
+{
+public:
+	/** Ray through the center of the screen, out to TraceDistance. Deprojects once per frame */
+	bool GetRay(APlayerController* PlayerController, FVector& OutStart, FVector& OutEnd);
+
+	/** Visibility hit along the crosshair ray. Traces once per frame */
+	bool GetHit(APlayerController* PlayerController, FHitResult& OutHitResult, FVector& OutHitLocation);
+
+	/** Returns true and the hit location if the crosshair trace already ran this frame */
+	bool GetCachedHitLocation(FVector& OutHitLocation) const;
+
+	/** Drop this frame's results; call when the camera moves within the frame */
+	void Invalidate();
+
+	/** Length of the crosshair ray */
+	static constexpr float TraceDistance{ 50'000.f };
+
+private:
+	/** Frame the ray and the hit were computed on */
+	uint64 RayFrame{ MAX_uint64 };
+	uint64 HitFrame{ MAX_uint64 };
+
+	bool bRayValid{ false };
+	FVector RayStart{ 0.f };
+	FVector RayEnd{ 0.f };
+
+	bool bHit{ false };
+	FHitResult HitResult;
+	FVector HitLocation{ 0.f };
+};
@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DamagePipelineSubsystem.h"
+#include "Enemy.h"
+#include "Engine/World.h"
+#include "Engine/DamageEvents.h"
+#include "GameFramework/DamageType.h"
+
+void UDamagePipelineSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	ApplyPendingDamage();
+}
+
+TStatId UDamagePipelineSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDamagePipelineSubsystem, STATGROUP_Tickables);
+}
+
+bool UDamagePipelineSubsystem::IsTickable() const
+{
+	return !PendingDamage.IsEmpty();
+}
+
+bool UDamagePipelineSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDamagePipelineSubsystem::QueueDamage(FDamageRecord&& Record)
+{
+	PendingDamage.Enqueue(MoveTemp(Record));
+}
+
+void UDamagePipelineSubsystem::QueueDamage(AActor* Target, float Damage, AController* EventInstigator, AActor* DamageCauser)
+{
+	if (Target == nullptr) return;
+
+	FDamageRecord Record;
+	Record.Target = Target;
+	Record.EventInstigator = EventInstigator;
+	Record.DamageCauser = DamageCauser;
+	Record.HitLocation = Target->GetActorLocation();
+	Record.Damage = Damage;
+	QueueDamage(MoveTemp(Record), Target->GetWorld());
+}
+
+void UDamagePipelineSubsystem::QueueDamage(FDamageRecord&& Record, const UWorld* World)
+{
+	UDamagePipelineSubsystem* DamagePipeline{ World ? World->GetSubsystem<UDamagePipelineSubsystem>() : nullptr };
+	if (DamagePipeline)
+	{
+		DamagePipeline->QueueDamage(MoveTemp(Record));
+	}
+	else
+	{
+		check(IsInGameThread());
+		ApplyDamage(Record);
+	}
+}
+
+void UDamagePipelineSubsystem::ApplyPendingDamage()
+{
+	check(IsInGameThread());
+
+	FDamageRecord Record;
+	while (PendingDamage.Dequeue(Record))
+	{
+		AActor* Target{ Record.Target.Get() };
+		if (Target == nullptr) continue;
+
+		int32* MergedIndex{ MergedIndices.Find(Target) };
+		if (MergedIndex == nullptr)
+		{
+			MergedIndices.Add(Target, MergedDamage.Num());
+			FMergedDamage& Merged{ MergedDamage.AddDefaulted_GetRef() };
+			Merged.LargestHit = Record.Damage;
+			Merged.Record = MoveTemp(Record);
+			continue;
+		}
+
+		FMergedDamage& Merged{ MergedDamage[*MergedIndex] };
+		Merged.Record.Damage += Record.Damage;
+		Merged.Record.HitLocation = Record.HitLocation;
+		Merged.Record.bHeadShot |= Record.bHeadShot;
+		Merged.Record.bShowHitNumber |= Record.bShowHitNumber;
+		if (Record.Damage > Merged.LargestHit)
+		{
+			Merged.LargestHit = Record.Damage;
+			Merged.Record.EventInstigator = Record.EventInstigator;
+			Merged.Record.DamageCauser = Record.DamageCauser;
+		}
+	}
+
+	// Reactions can queue more damage (e.g. a dying enemy); that waits for the next frame
+	for (const FMergedDamage& Merged : MergedDamage)
+	{
+		ApplyDamage(Merged.Record);
+	}
+	MergedDamage.Reset();
+	MergedIndices.Reset();
+}
+
+void UDamagePipelineSubsystem::ApplyDamage(const FDamageRecord& Record)
+{
+	AActor* Target{ Record.Target.Get() };
+	if (Target == nullptr || Record.Damage == 0.f) return;
+
+	// Same as UGameplayStatics::ApplyDamage
+	const FDamageEvent DamageEvent(UDamageType::StaticClass());
+	const float AppliedDamage{ Target->TakeDamage(Record.Damage, DamageEvent, Record.EventInstigator.Get(), Record.DamageCauser.Get()) };
+
+	if (Record.bShowHitNumber)
+	{
+		if (AEnemy* Enemy{ Cast<AEnemy>(Target) })
+		{
+			Enemy->ShowHitNumber(FMath::RoundToInt(AppliedDamage), Record.HitLocation, Record.bHeadShot);
+		}
+	}
+}
@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Containers/Queue.h"
+#include "DamagePipelineSubsystem.generated.h"
+
+/** One hit waiting to be applied */
+struct FDamageRecord
+{
+	TWeakObjectPtr<AActor> Target;
+	TWeakObjectPtr<AController> EventInstigator;
+	TWeakObjectPtr<AActor> DamageCauser;
+
+	/** Where the hit landed; used for the hit number */
+	FVector HitLocation{ 0.f };
+
+	float Damage{ 0.f };
+
+	bool bHeadShot{ false };
+
+	/** Show a hit number on the target if it is an AEnemy */
+	bool bShowHitNumber{ false };
+};
+
+/**
+ * Applies all damage once per frame, after the frame's shots and melee hits have resolved.
+ * Producers on any thread push FDamageRecords into a lock-free MPSC queue; the game thread
+ * drains it in Tick, merges the hits on each target and calls TakeDamage once per target,
+ * so hit reactions, stun rolls and hit numbers also happen once per target per frame.
+ */
+UCLASS()
+class SHOOTER_API UDamagePipelineSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override;
+
+	/** Queue a hit to be applied at the end of the frame. Safe to call from any thread */
+	void QueueDamage(FDamageRecord&& Record);
+
+	/**
+	 * Queue a hit through the target's world pipeline, or apply it right away (game thread only)
+	 * in worlds that don't have one.
+	 */
+	static void QueueDamage(AActor* Target, float Damage, AController* EventInstigator, AActor* DamageCauser);
+	static void QueueDamage(FDamageRecord&& Record, const UWorld* World);
+
+	/** Drain the queue and apply the merged damage now */
+	void ApplyPendingDamage();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Every hit on one target this frame, summed */
+	struct FMergedDamage
+	{
+		FDamageRecord Record;
+
+		/** Largest single hit; its instigator and causer get the credit */
+		float LargestHit{ 0.f };
+	};
+
+	/** Apply one merged hit and trigger its reactions */
+	static void ApplyDamage(const FDamageRecord& Record);
+
+	TQueue<FDamageRecord, EQueueMode::Mpsc> PendingDamage;
+
+	/** Hits merged per target this frame; kept around so the containers don't reallocate every frame */
+	TArray<FMergedDamage> MergedDamage;
+	TMap<AActor*, int32> MergedIndices;
+};
@@ -0,0 +1,114 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DetonationSubsystem.h"
+#include "Explosive.h"
+
+UDetonationSubsystem::UDetonationSubsystem() :
+	MaxDetonationsPerFrame(4),
+	MaxEmittersPerFrame(4),
+	MaxDamageApplicationsPerFrame(32),
+	ChainDelayMin(0.08f),
+	ChainDelayMax(0.2f)
+{
+}
+
+void UDetonationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Now{ GetWorld()->GetTimeSeconds() };
+	int32 NumDetonations{ 0 };
+	FDetonationCost FrameCost;
+
+	while (PendingDetonations.Num() > 0 && PendingDetonations.HeapTop().DetonateTime <= Now)
+	{
+		// Always make progress, then stop at the first exhausted budget
+		if (NumDetonations > 0 &&
+			(NumDetonations >= MaxDetonationsPerFrame ||
+			FrameCost.NumEmitters >= MaxEmittersPerFrame ||
+			FrameCost.NumDamageApplications >= MaxDamageApplicationsPerFrame))
+		{
+			break;
+		}
+
+		FPendingDetonation Detonation;
+		PendingDetonations.HeapPop(Detonation, false);
+
+		// Explosives destroyed while queued already left QueuedExplosives in UnregisterExplosive
+		AExplosive* Explosive{ Detonation.Explosive.Get() };
+		if (!IsValid(Explosive)) continue;
+		QueuedExplosives.Remove(Explosive);
+
+		const FVector Location{ Explosive->GetActorLocation() };
+		const float ChainRadius{ Explosive->GetChainReactionRadius() };
+
+		const FDetonationCost Cost{ Explosive->Detonate(Detonation.Shooter.Get(), Detonation.ShooterController.Get(), Detonation.EffectLocation) };
+		FrameCost.NumEmitters += Cost.NumEmitters;
+		FrameCost.NumDamageApplications += Cost.NumDamageApplications;
+		NumDetonations++;
+
+		PropagateDetonation(Location, ChainRadius, Detonation);
+	}
+}
+
+TStatId UDetonationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDetonationSubsystem, STATGROUP_Tickables);
+}
+
+bool UDetonationSubsystem::IsTickable() const
+{
+	return PendingDetonations.Num() > 0;
+}
+
+bool UDetonationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDetonationSubsystem::RegisterExplosive(AExplosive* Explosive)
+{
+	if (Explosive == nullptr || Grid.Contains(Explosive)) return;
+
+	Explosives.Add(Explosive);
+	Grid.Add(Explosive, Explosive->GetActorLocation());
+}
+
+void UDetonationSubsystem::UnregisterExplosive(AExplosive* Explosive)
+{
+	QueuedExplosives.Remove(Explosive);
+	if (!Grid.Contains(Explosive)) return;
+
+	Explosives.RemoveSingleSwap(Explosive, false);
+	Grid.Remove(Explosive);
+}
+
+void UDetonationSubsystem::QueueDetonation(AExplosive* Explosive, float Delay, AActor* Shooter, AController* ShooterController, const FVector& EffectLocation)
+{
+	if (Explosive == nullptr || QueuedExplosives.Contains(Explosive)) return;
+
+	FPendingDetonation Detonation;
+	Detonation.Explosive = Explosive;
+	Detonation.Shooter = Shooter;
+	Detonation.ShooterController = ShooterController;
+	Detonation.EffectLocation = EffectLocation;
+	Detonation.DetonateTime = GetWorld()->GetTimeSeconds() + Delay;
+
+	QueuedExplosives.Add(Explosive);
+	PendingDetonations.HeapPush(MoveTemp(Detonation));
+}
+
+void UDetonationSubsystem::PropagateDetonation(const FVector& Location, float Radius, const FPendingDetonation& Source)
+{
+	if (Radius <= 0.f) return;
+
+	TArray<AExplosive*, TInlineAllocator<16>> Neighbors;
+	Grid.QuerySphere(Location, Radius, Neighbors);
+
+	// The instigator of the first blast gets credit for the whole chain
+	for (AExplosive* Neighbor : Neighbors)
+	{
+		QueueDetonation(Neighbor, FMath::FRandRange(ChainDelayMin, ChainDelayMax), Source.Shooter.Get(), Source.ShooterController.Get(), Neighbor->GetActorLocation());
+	}
+}
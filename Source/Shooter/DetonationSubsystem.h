@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SpatialHashGrid.h"
+#include "UObject/ObjectKey.h"
+#include "DetonationSubsystem.generated.h"
+
+class AExplosive;
+
+/**
+ * Schedules explosive detonations and chain reactions.
+ * A detonation queues every explosive within its chain radius after a short random delay.
+ * Detonations due this frame are processed under a budget of explosions, emitters and
+ * damage applications; whatever doesn't fit waits for the next frame. A field of barrels
+ * therefore cascades over several frames instead of exploding in one long one.
+ */
+UCLASS(Config = Game)
+class SHOOTER_API UDetonationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UDetonationSubsystem();
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override;
+
+	void RegisterExplosive(AExplosive* Explosive);
+	void UnregisterExplosive(AExplosive* Explosive);
+
+	/** Detonate the explosive Delay seconds from now, unless it is already queued. Its emitter spawns at EffectLocation */
+	void QueueDetonation(AExplosive* Explosive, float Delay, AActor* Shooter, AController* ShooterController, const FVector& EffectLocation);
+
+	FORCEINLINE int32 GetNumPendingDetonations() const { return PendingDetonations.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FPendingDetonation
+	{
+		TWeakObjectPtr<AExplosive> Explosive;
+		TWeakObjectPtr<AActor> Shooter;
+		TWeakObjectPtr<AController> ShooterController;
+		FVector EffectLocation{ FVector::ZeroVector };
+		double DetonateTime{ 0.0 };
+
+		/** Min-heap on DetonateTime */
+		bool operator<(const FPendingDetonation& Other) const { return DetonateTime < Other.DetonateTime; }
+	};
+
+	/** Queue every registered explosive within Radius of Location */
+	void PropagateDetonation(const FVector& Location, float Radius, const FPendingDetonation& Source);
+
+	UPROPERTY(Config, EditAnywhere, Category = Budget)
+	int32 MaxDetonationsPerFrame;
+
+	UPROPERTY(Config, EditAnywhere, Category = Budget)
+	int32 MaxEmittersPerFrame;
+
+	UPROPERTY(Config, EditAnywhere, Category = Budget)
+	int32 MaxDamageApplicationsPerFrame;
+
+	/** Random delay, in seconds, before a neighbor caught in a blast detonates */
+	UPROPERTY(Config, EditAnywhere, Category = "Chain Reaction")
+	float ChainDelayMin;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Chain Reaction")
+	float ChainDelayMax;
+
+	UPROPERTY()
+	TArray<AExplosive*> Explosives;
+
+	/** Explosive locations; explosives are assumed not to move once placed */
+	TSpatialHashGrid<AExplosive*> Grid;
+
+	/** Heap of detonations ordered by time */
+	TArray<FPendingDetonation> PendingDetonations;
+
+	/** Explosives in PendingDetonations, so each one is only queued once. Entries leave in Tick or UnregisterExplosive */
+	TSet<FObjectKey> QueuedExplosives;
+};
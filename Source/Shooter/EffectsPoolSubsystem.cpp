@@ -0,0 +1,155 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EffectsPoolSubsystem.h"
+#include "Kismet/GameplayStatics.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "ShooterStats.h"
+
+UEffectsPoolSubsystem::UEffectsPoolSubsystem() :
+	ComponentsPerEffect(16)
+{
+}
+
+void UEffectsPoolSubsystem::Deinitialize()
+{
+	for (TPair<UParticleSystem*, FPooledEffects>& Pool : Pools)
+	{
+		for (UParticleSystemComponent* Component : Pool.Value.Components)
+		{
+			if (IsValid(Component))
+			{
+				Component->DestroyComponent();
+			}
+		}
+	}
+	Pools.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UEffectsPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEffectsPoolSubsystem::WarmPool(UParticleSystem* Template)
+{
+	if (Template)
+	{
+		FindOrCreatePool(Template);
+	}
+}
+
+UParticleSystemComponent* UEffectsPoolSubsystem::PlayEffect(UParticleSystem* Template, const FTransform& Transform)
+{
+	UParticleSystemComponent* Component{ AcquireComponent(Template) };
+	if (Component == nullptr) return nullptr;
+
+	Component->SetWorldLocationAndRotation(Transform.GetLocation(), Transform.GetRotation());
+	Component->SetRelativeScale3D(Transform.GetScale3D());
+	Component->Activate(true);
+	return Component;
+}
+
+UParticleSystemComponent* UEffectsPoolSubsystem::PlayBeam(UParticleSystem* Template, const FTransform& Transform, const FVector& Target)
+{
+	UParticleSystemComponent* Component{ PlayEffect(Template, Transform) };
+	if (Component)
+	{
+		Component->SetVectorParameter(FName("Target"), Target);
+	}
+	return Component;
+}
+
+UParticleSystemComponent* UEffectsPoolSubsystem::PlayEffect(const UWorld* World, UParticleSystem* Template, const FTransform& Transform)
+{
+	if (World == nullptr || Template == nullptr) return nullptr;
+
+	UEffectsPoolSubsystem* EffectsPool{ World->GetSubsystem<UEffectsPoolSubsystem>() };
+	if (EffectsPool)
+	{
+		return EffectsPool->PlayEffect(Template, Transform);
+	}
+	SHOOTER_INC_COUNTER(EmittersSpawned);
+	return UGameplayStatics::SpawnEmitterAtLocation(const_cast<UWorld*>(World), Template, Transform);
+}
+
+UParticleSystemComponent* UEffectsPoolSubsystem::PlayBeam(const UWorld* World, UParticleSystem* Template, const FTransform& Transform, const FVector& Target)
+{
+	UParticleSystemComponent* Component{ PlayEffect(World, Template, Transform) };
+	if (Component)
+	{
+		Component->SetVectorParameter(FName("Target"), Target);
+	}
+	return Component;
+}
+
+FPooledEffects& UEffectsPoolSubsystem::FindOrCreatePool(UParticleSystem* Template)
+{
+	FPooledEffects* ExistingPool{ Pools.Find(Template) };
+	if (ExistingPool) return *ExistingPool;
+
+	FPooledEffects& Pool{ Pools.Add(Template) };
+	UWorld* World{ GetWorld() };
+	const int32 NumComponents{ FMath::Max(ComponentsPerEffect, 1) };
+	SHOOTER_INC_COUNTER_BY(EmittersSpawned, NumComponents);
+	Pool.Components.Reserve(NumComponents);
+	Pool.LastPlayedTimes.Reserve(NumComponents);
+
+	for (int32 Index = 0; Index < NumComponents; Index++)
+	{
+		// Same setup UGameplayStatics gives a spawned emitter, except the component outlives its system
+		UParticleSystemComponent* Component{ NewObject<UParticleSystemComponent>(World->GetWorldSettings()) };
+		Component->bAutoDestroy = false;
+		Component->bAutoActivate = false;
+		Component->SecondsBeforeInactive = 0.f;
+		Component->SetTemplate(Template);
+		Component->SetUsingAbsoluteLocation(true);
+		Component->SetUsingAbsoluteRotation(true);
+		Component->SetUsingAbsoluteScale(true);
+		Component->RegisterComponentWithWorld(World);
+
+		Pool.Components.Add(Component);
+		Pool.LastPlayedTimes.Add(0.0);
+	}
+	return Pool;
+}
+
+UParticleSystemComponent* UEffectsPoolSubsystem::AcquireComponent(UParticleSystem* Template)
+{
+	if (Template == nullptr) return nullptr;
+
+	FPooledEffects& Pool{ FindOrCreatePool(Template) };
+
+	// A finished system deactivates itself, which returns its component to the pool
+	int32 ChosenIndex{ INDEX_NONE };
+	double OldestTime{ TNumericLimits<double>::Max() };
+	for (int32 Index = 0; Index < Pool.Components.Num(); Index++)
+	{
+		UParticleSystemComponent* Component{ Pool.Components[Index] };
+		if (!IsValid(Component)) continue;
+
+		if (!Component->IsActive())
+		{
+			ChosenIndex = Index;
+			break;
+		}
+		if (Pool.LastPlayedTimes[Index] < OldestTime)
+		{
+			OldestTime = Pool.LastPlayedTimes[Index];
+			ChosenIndex = Index;
+		}
+	}
+	if (ChosenIndex == INDEX_NONE) return nullptr;
+
+	UParticleSystemComponent* Component{ Pool.Components[ChosenIndex] };
+	if (Component->IsActive())
+	{
+		// Pool exhausted; drop the oldest effect still playing
+		Component->DeactivateImmediate();
+	}
+	Pool.LastPlayedTimes[ChosenIndex] = GetWorld()->GetTimeSeconds();
+	return Component;
+}
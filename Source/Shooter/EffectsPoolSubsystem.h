@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EffectsPoolSubsystem.generated.h"
+
+class UParticleSystem;
+class UParticleSystemComponent;
+
+/** Reusable components for one particle system, with the world time each was last played */
+USTRUCT()
+struct FPooledEffects
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<UParticleSystemComponent*> Components;
+
+	TArray<double> LastPlayedTimes;
+};
+
+/**
+ * Plays short-lived particle effects from pools of reusable components.
+ * Each particle system gets a fixed number of components the first time it is played (or warmed);
+ * a component goes back to the pool when its system finishes. When every component is still
+ * playing, the one played longest ago is cut short and reused.
+ */
+UCLASS(Config = Game)
+class SHOOTER_API UEffectsPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UEffectsPoolSubsystem();
+
+	virtual void Deinitialize() override;
+
+	/** Create the pool for this particle system now rather than on first play */
+	void WarmPool(UParticleSystem* Template);
+
+	/**
+	 * Play the effect at Transform. The returned component belongs to the pool and may be reused
+	 * by a later call; don't hold on to it.
+	 */
+	UParticleSystemComponent* PlayEffect(UParticleSystem* Template, const FTransform& Transform);
+
+	/** Play a beam effect from Transform, setting its Target vector parameter */
+	UParticleSystemComponent* PlayBeam(UParticleSystem* Template, const FTransform& Transform, const FVector& Target);
+
+	/** Play through the world's pool, or spawn a one-off emitter in worlds that don't have one */
+	static UParticleSystemComponent* PlayEffect(const UWorld* World, UParticleSystem* Template, const FTransform& Transform);
+	static UParticleSystemComponent* PlayBeam(const UWorld* World, UParticleSystem* Template, const FTransform& Transform, const FVector& Target);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FPooledEffects& FindOrCreatePool(UParticleSystem* Template);
+
+	/** A finished component, or the least recently played one */
+	UParticleSystemComponent* AcquireComponent(UParticleSystem* Template);
+
+	/** Components created for each particle system */
+	UPROPERTY(Config, EditAnywhere, Category = Pool)
+	int32 ComponentsPerEffect;
+
+	UPROPERTY()
+	TMap<UParticleSystem*, FPooledEffects> Pools;
+};
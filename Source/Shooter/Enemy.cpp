@@ -6,6 +6,8 @@
 #include "Sound/SoundCue.h"
 #include "Particles/ParticleSystem.h"
 #include "Blueprint/UserWidget.h"
+#include "HitNumberSubsystem.h"
+#include "HitNumberWidget.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "EnemyController.h"
 #include "BehaviorTree/BlackboardComponent.h"
@@ -14,17 +16,51 @@
 #include "Components/CapsuleComponent.h"
 #include "Components/BoxComponent.h"
 #include "Engine/SkeletalMeshSocket.h"
+#include "Shooter.h"
+#include "EnemySignificanceSubsystem.h"
+#include "ShooterCounters.h"
+#include "ShooterStats.h"
+#include "DamagePipelineSubsystem.h"
+#include "CharacterGridSubsystem.h"
+#include "EffectsPoolSubsystem.h"
+#include "ShooterAudioSubsystem.h"
+#include "CooldownComponent.h"
+#include "UObject/UObjectIterator.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Ticking enemies"), STAT_TickingEnemies, STATGROUP_Shooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Dormant enemies"), STAT_DormantEnemies, STATGROUP_Shooter);
+
+static void OnEnemyForceTickChanged(IConsoleVariable* Variable)
+{
+	for (TObjectIterator<AEnemy> It; It; ++It)
+	{
+		if (It->HasActorBegunPlay())
+		{
+			if (Variable->GetBool())
+			{
+				It->AddTickReason(EEnemyTickReason::ETR_ForceTick);
+			}
+			else
+			{
+				It->RemoveTickReason(EEnemyTickReason::ETR_ForceTick);
+			}
+		}
+	}
+}
+
+static TAutoConsoleVariable<bool> CVarEnemyForceTick(
+	TEXT("shooter.Enemy.ForceTick"),
+	false,
+	TEXT("Tick every enemy every frame, as before enemies only ticked on demand. Compare with stat Shooter."),
+	FConsoleVariableDelegate::CreateStatic(&OnEnemyForceTickChanged));
 
 // Sets default values
 AEnemy::AEnemy() :
-	Health(100.f),
 	MaxHealth(100.f),
 	HealthBarDisplayTime(4.f),
-	bCanHitReact(true),
 	HitReactTimeMin(0.5f),
 	HitReactTimeMax(1.0f),
 	HitNumberDestroyTime(1.5f),
-	bStunned(false),
 	StunChance(0.5f),
 	AttackLFast(TEXT("AttackLFast")),
 	AttackRFast(TEXT("AttackRFast")),
@@ -33,13 +69,15 @@ AEnemy::AEnemy() :
 	BaseDamage(20.f),
 	LeftWeaponSocket(TEXT("FX_Trail_L_01")),
 	RightWeaponSocket(TEXT("FX_Trail_R_01")),
-	bCanAttack(true),
 	AttackWaitTime(1.f),
-	bDying(false),
-	DeathTime(4.f)
+	DeathTime(4.f),
+	TickReasons(EEnemyTickReason::ETR_None),
+	bHasTarget(false),
+	EnemyState(nullptr)
 {
- 	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+ 	// Enemies only tick while they have a tick reason, see UpdateActorTick
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	AgroSphere = CreateDefaultSubobject<USphereComponent>(TEXT("AgroSphere"));
 	AgroSphere->SetupAttachment(GetRootComponent());
@@ -54,6 +92,12 @@ AEnemy::AEnemy() :
 	RightWeaponCollision = CreateDefaultSubobject<UBoxComponent>(TEXT("Right Weapon Box"));
 	RightWeaponCollision->SetupAttachment(GetMesh(), FName("RightWeaponBone"));
 
+	Cooldowns = CreateDefaultSubobject<UCooldownComponent>(TEXT("Cooldowns"));
+	HealthBarCooldown = Cooldowns->AddCooldown(FSimpleDelegate::CreateUObject(this, &AEnemy::HideHealthBar));
+	HitReactCooldown = Cooldowns->AddCooldown(FSimpleDelegate::CreateUObject(this, &AEnemy::ResetHitReactTimer));
+	AttackWaitCooldown = Cooldowns->AddCooldown(FSimpleDelegate::CreateUObject(this, &AEnemy::ResetCanAttack));
+
+	LocalState.Flags = EEnemyStateFlags::ESF_CanAttack | EEnemyStateFlags::ESF_CanHitReact;
 }
 
 // Called when the game starts or when spawned
@@ -61,6 +105,36 @@ void AEnemy::BeginPlay()
 {
 	Super::BeginPlay();
 
+	LocalState.Health = MaxHealth;
+	EnemyState = GetWorld()->GetSubsystem<UEnemyStateSubsystem>();
+	if (EnemyState)
+	{
+		StateHandle = EnemyState->AddEnemy(this, LocalState);
+	}
+
+	INC_DWORD_STAT(STAT_DormantEnemies);
+	if (GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(AEnemy, ReceiveTick)))
+	{
+		TickReasons |= EEnemyTickReason::ETR_Blueprint;
+	}
+	if (CVarEnemyForceTick.GetValueOnGameThread())
+	{
+		TickReasons |= EEnemyTickReason::ETR_ForceTick;
+	}
+	UpdateActorTick();
+
+	UEnemySignificanceSubsystem* SignificanceSubsystem{ GetWorld()->GetSubsystem<UEnemySignificanceSubsystem>() };
+	if (SignificanceSubsystem)
+	{
+		SignificanceSubsystem->RegisterEnemy(this);
+	}
+
+	UCharacterGridSubsystem* CharacterGrid{ GetWorld()->GetSubsystem<UCharacterGridSubsystem>() };
+	if (CharacterGrid)
+	{
+		CharacterGrid->RegisterCharacter(this);
+	}
+
 	AgroSphere->OnComponentBeginOverlap.AddDynamic(
 		this,
 		&AEnemy::AgroSphereOverlap);
@@ -109,8 +183,8 @@ void AEnemy::BeginPlay()
 
 	if (EnemyController)
 	{
-		EnemyController->GetBlackboardComponent()->SetValueAsBool(
-			FName("CanAttack"),
+		EnemyController->SetBlackboardBool(
+			EEnemyBlackboardKey::EBK_CanAttack,
 			true);
 	}
 
@@ -119,11 +193,11 @@ void AEnemy::BeginPlay()
 	if (EnemyController)
 	{
 		//Blackboardda oluturduumuz deikene devriye verisini atyoruz(Patrol = devriye)
-		EnemyController->GetBlackboardComponent()->SetValueAsVector(
-			TEXT("PatrolPoint"),
+		EnemyController->SetBlackboardVector(
+			EEnemyBlackboardKey::EBK_PatrolPoint,
 			WorldPatrolPoint);
-		EnemyController->GetBlackboardComponent()->SetValueAsVector(
-			TEXT("PatrolPoint2"),
+		EnemyController->SetBlackboardVector(
+			EEnemyBlackboardKey::EBK_PatrolPoint2,
 			WorldPatrolPoint2);
 
 		EnemyController->RunBehaviorTree(BehaviorTree);
@@ -134,18 +208,13 @@ void AEnemy::BeginPlay()
 
 void AEnemy::ShowHealthBar_Implementation()
 {
-	GetWorldTimerManager().ClearTimer(HealthBarTimer);
-	GetWorldTimerManager().SetTimer(
-		HealthBarTimer, 
-		this, 
-		&AEnemy::HideHealthBar,
-		HealthBarDisplayTime);
+	Cooldowns->StartCooldown(HealthBarCooldown, HealthBarDisplayTime);
 }
 
 void AEnemy::Die()
 {
-	if (bDying) return;
-	bDying = true;
+	if (IsDying()) return;
+	SetStateFlags(EEnemyStateFlags::ESF_Dying, true);
 
 	HideHealthBar();
 
@@ -157,17 +226,17 @@ void AEnemy::Die()
 
 	if (EnemyController)
 	{
-		EnemyController->GetBlackboardComponent()->SetValueAsBool(
-			FName("Dead"),
-			true
-		);
+		EnemyController->SetBlackboardBool(
+			EEnemyBlackboardKey::EBK_Dead,
+			true);
 		EnemyController->StopMovement();
 	}
+	LoseTarget();
 }
 
 void AEnemy::PlayHitMontage(FName Section, float PlayRate)
 {
-	if (bCanHitReact)
+	if (HasStateFlags(EEnemyStateFlags::ESF_CanHitReact))
 	{
 		UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
 		if (AnimInstance)
@@ -175,57 +244,47 @@ void AEnemy::PlayHitMontage(FName Section, float PlayRate)
 			AnimInstance->Montage_Play(HitMontage, PlayRate);
 			AnimInstance->Montage_JumpToSection(Section, HitMontage);
 		}
-		bCanHitReact = false;
+		SetStateFlags(EEnemyStateFlags::ESF_CanHitReact, false);
 
 		const float HitReactTime{ FMath::FRandRange(HitReactTimeMin,HitReactTimeMax) };
-		GetWorldTimerManager().SetTimer(
-			HitReactTimer, 
-			this, 
-			&AEnemy::ResetHitReactTimer,
-			HitReactTime);
+		Cooldowns->StartCooldown(HitReactCooldown, HitReactTime);
 	}
 }
 	
 
 void AEnemy::ResetHitReactTimer()
 {
-	bCanHitReact = true;
+	SetStateFlags(EEnemyStateFlags::ESF_CanHitReact, true);
 }
 
-void AEnemy::StoreHitNumber(UUserWidget* HitNumber, FVector Location)
+void AEnemy::ShowHitNumber_Implementation(int32 Damage, FVector HitLocation, bool bHeadShot)
 {
-	HitNumbers.Add(HitNumber, Location);
-
-	FTimerHandle HitNumberTimer;
-	FTimerDelegate HitNumberDelegate;
-	HitNumberDelegate.BindUFunction(this, FName("DestroyHitNumber"),HitNumber);
-
-	GetWorld()->GetTimerManager().SetTimer(
-		HitNumberTimer, 
-		HitNumberDelegate,
-		HitNumberDestroyTime,
-		false);
+	// The subsystem positions and expires the number
+	UHitNumberSubsystem* HitNumberSubsystem{ GetWorld()->GetSubsystem<UHitNumberSubsystem>() };
+	if (HitNumberSubsystem && HitNumberWidgetClass)
+	{
+		HitNumberSubsystem->ShowHitNumber(HitNumberWidgetClass, Damage, HitLocation, bHeadShot, HitNumberDestroyTime);
+	}
 }
 
-void AEnemy::DestroyHitNumber(UUserWidget* HitNumber)
+void AEnemy::StoreHitNumber(UUserWidget* HitNumber, FVector Location)
 {
-	HitNumbers.Remove(HitNumber);
-	HitNumber->RemoveFromParent();
-}
+	if (HitNumber == nullptr) return;
 
-void AEnemy::UpdateHitNumbers()
-{
-	for (auto& HitPair : HitNumbers)
+	UHitNumberSubsystem* HitNumberSubsystem{ GetWorld()->GetSubsystem<UHitNumberSubsystem>() };
+	if (HitNumberSubsystem)
 	{
-		UUserWidget* HitNumber{ HitPair.Key };
-		const FVector Location{ HitPair.Value };
-		FVector2D ScreenPosition;
-
-		UGameplayStatics::ProjectWorldToScreen(
-			GetWorld()->GetFirstPlayerController(),
-			Location,
-			ScreenPosition);
-		HitNumber->SetPositionInViewport(ScreenPosition);
+		HitNumberSubsystem->StoreHitNumber(HitNumber, Location, HitNumberDestroyTime);
+	}
+	else
+	{
+		// Nothing positions it without the subsystem; just make sure it goes away
+		FTimerHandle HitNumberTimer;
+		GetWorldTimerManager().SetTimer(
+			HitNumberTimer,
+			FTimerDelegate::CreateWeakLambda(HitNumber, [HitNumber]() { HitNumber->RemoveFromParent(); }),
+			HitNumberDestroyTime,
+			false);
 	}
 }
 
@@ -241,21 +300,42 @@ void AEnemy::AgroSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor*
 			if (EnemyController->GetBlackboardComponent())
 			{
 				//Set the value of the target Blackboard Key
-				EnemyController->GetBlackboardComponent()->SetValueAsObject(
-					TEXT("Target"),
+				EnemyController->SetBlackboardObject(
+					EEnemyBlackboardKey::EBK_Target,
 					Character);
 			}
 		}
+		bHasTarget = true;
+		RefreshSignificance();
 	}
 }
 
+AActor* AEnemy::GetTarget() const
+{
+	return EnemyController ? Cast<AActor>(EnemyController->GetBlackboardObject(EEnemyBlackboardKey::EBK_Target)) : nullptr;
+}
+
+void AEnemy::LoseTarget()
+{
+	if (!bHasTarget) return;
+
+	if (EnemyController)
+	{
+		EnemyController->SetBlackboardObject(
+			EEnemyBlackboardKey::EBK_Target,
+			nullptr);
+	}
+	bHasTarget = false;
+	RefreshSignificance();
+}
+
 void AEnemy::SetStunned(bool Stunned)
 {
-	bStunned = Stunned;
+	SetStateFlags(EEnemyStateFlags::ESF_Stunned, Stunned);
 	if (EnemyController)
 	{
-		EnemyController->GetBlackboardComponent()->SetValueAsBool(
-			TEXT("Stunned"),
+		EnemyController->SetBlackboardBool(
+			EEnemyBlackboardKey::EBK_Stunned,
 			Stunned);
 	}
 }
@@ -266,13 +346,14 @@ void AEnemy::CombatRangeOverlap(UPrimitiveComponent* OverlappedComponent, AActor
 	auto ShooterCharacter = Cast<AShooterCharacter>(OtherActor);
 	if (ShooterCharacter)
 	{
-		bInAttackRange = true;
+		SetStateFlags(EEnemyStateFlags::ESF_InAttackRange, true);
 		if (EnemyController)
 		{
-			EnemyController->GetBlackboardComponent()->SetValueAsBool(
-				TEXT("InAttackRange"),
+			EnemyController->SetBlackboardBool(
+				EEnemyBlackboardKey::EBK_InAttackRange,
 				true);
 		}
+		RefreshSignificance();
 	}
 	
 }
@@ -284,11 +365,11 @@ void AEnemy::CombatRangeEndOverlap(UPrimitiveComponent* OverlappedComponent, AAc
 	auto ShooterCharacter = Cast<AShooterCharacter>(OtherActor);
 	if (ShooterCharacter)
 	{
-		bInAttackRange = false;
+		SetStateFlags(EEnemyStateFlags::ESF_InAttackRange, false);
 		if (EnemyController)
 		{
-			EnemyController->GetBlackboardComponent()->SetValueAsBool(
-				TEXT("InAttackRange"),
+			EnemyController->SetBlackboardBool(
+				EEnemyBlackboardKey::EBK_InAttackRange,
 				false);
 		}
 	}
@@ -296,23 +377,21 @@ void AEnemy::CombatRangeEndOverlap(UPrimitiveComponent* OverlappedComponent, AAc
 
 void AEnemy::PlayAttackMontage(FName Section, float PlayRate)
 {
+	// Still waiting out AttackWaitTime from the last attack
+	if (!HasStateFlags(EEnemyStateFlags::ESF_CanAttack)) return;
+
 	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
 	if (AnimInstance && AttackMontage)
 	{
 		AnimInstance->Montage_Play(AttackMontage);
 		AnimInstance->Montage_JumpToSection(Section, AttackMontage);
 	}
-	bCanAttack = false;
-	GetWorldTimerManager().SetTimer(
-		AttackWaitTimer,
-		this,
-		&AEnemy::ResetCanAttack,
-		AttackWaitTime
-	);
+	SetStateFlags(EEnemyStateFlags::ESF_CanAttack, false);
+	Cooldowns->StartCooldown(AttackWaitCooldown, AttackWaitTime);
 	if (EnemyController)
 	{
-		EnemyController->GetBlackboardComponent()->SetValueAsBool(
-			FName("CanAttack"),
+		EnemyController->SetBlackboardBool(
+			EEnemyBlackboardKey::EBK_CanAttack,
 			false);
 	}
 }
@@ -343,16 +422,15 @@ void  AEnemy::DoDamage(AShooterCharacter* Victim)
 {
 	if (Victim == nullptr) return;
 
-	UGameplayStatics::ApplyDamage(
+	UDamagePipelineSubsystem::QueueDamage(
 		Victim,
 		BaseDamage,
 		EnemyController,
-		this,
-		UDamageType::StaticClass());
+		this);
 	if (Victim->GetMeleeImpactSound())
 	{
-		UGameplayStatics::PlaySoundAtLocation(
-			this, 
+		UShooterAudioSubsystem::PlaySoundAtLocation(
+			GetWorld(),
 			Victim->GetMeleeImpactSound(),
 			GetActorLocation());
 	}
@@ -367,6 +445,7 @@ void AEnemy::SpawnBlood(AShooterCharacter* Victim, FName SocketName)
 		const FTransform SocketTransform{ TipSocket->GetSocketTransform(GetMesh()) };
 		if (Victim->GetBloodParticle())
 		{
+			SHOOTER_INC_COUNTER(EmittersSpawned);
 			UGameplayStatics::SpawnEmitterAtLocation(
 				GetWorld(),
 				Victim->GetBloodParticle(),
@@ -389,11 +468,11 @@ void AEnemy::StunCharacter(AShooterCharacter* Victim)
 
 void AEnemy::ResetCanAttack()
 {
-	bCanAttack = true;
+	SetStateFlags(EEnemyStateFlags::ESF_CanAttack, true);
 	if (EnemyController)
 	{
-		EnemyController->GetBlackboardComponent()->SetValueAsBool(
-			FName("CanAttack"),
+		EnemyController->SetBlackboardBool(
+			EEnemyBlackboardKey::EBK_CanAttack,
 			true);
 	}
 }
@@ -455,12 +534,120 @@ void AEnemy::DeactivateRightWeapon()
 	RightWeaponCollision->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 }
 
+void AEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (IsActorTickEnabled())
+	{
+		DEC_DWORD_STAT(STAT_TickingEnemies);
+	}
+	else
+	{
+		DEC_DWORD_STAT(STAT_DormantEnemies);
+	}
+
+	UEnemySignificanceSubsystem* SignificanceSubsystem{ GetWorld()->GetSubsystem<UEnemySignificanceSubsystem>() };
+	if (SignificanceSubsystem)
+	{
+		SignificanceSubsystem->UnregisterEnemy(this);
+	}
+
+	UCharacterGridSubsystem* CharacterGrid{ GetWorld()->GetSubsystem<UCharacterGridSubsystem>() };
+	if (CharacterGrid)
+	{
+		CharacterGrid->UnregisterCharacter(this);
+	}
+
+	if (EnemyState)
+	{
+		LocalState = EnemyState->RemoveEnemy(StateHandle);
+		EnemyState = nullptr;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+bool AEnemy::HasStateFlags(EEnemyStateFlags Flags) const
+{
+	return EnemyState ? EnemyState->HasAnyFlags(StateHandle, Flags) : EnumHasAnyFlags(LocalState.Flags, Flags);
+}
+
+void AEnemy::SetStateFlags(EEnemyStateFlags Flags, bool bValue)
+{
+	if (EnemyState)
+	{
+		EnemyState->SetFlags(StateHandle, Flags, bValue);
+	}
+	else if (bValue)
+	{
+		LocalState.Flags |= Flags;
+	}
+	else
+	{
+		LocalState.Flags &= ~Flags;
+	}
+}
+
+float AEnemy::GetHealth() const
+{
+	return EnemyState ? EnemyState->GetHealth(StateHandle) : LocalState.Health;
+}
+
+void AEnemy::SetHealth(float NewHealth)
+{
+	if (EnemyState)
+	{
+		EnemyState->SetHealth(StateHandle, NewHealth);
+	}
+	else
+	{
+		LocalState.Health = NewHealth;
+	}
+}
+
+void AEnemy::RefreshSignificance()
+{
+	UEnemySignificanceSubsystem* SignificanceSubsystem{ GetWorld()->GetSubsystem<UEnemySignificanceSubsystem>() };
+	if (SignificanceSubsystem)
+	{
+		SignificanceSubsystem->RefreshEnemy(this);
+	}
+}
+
+void AEnemy::AddTickReason(EEnemyTickReason Reason)
+{
+	TickReasons |= Reason;
+	UpdateActorTick();
+}
+
+void AEnemy::RemoveTickReason(EEnemyTickReason Reason)
+{
+	TickReasons &= ~Reason;
+	UpdateActorTick();
+}
+
+void AEnemy::UpdateActorTick()
+{
+	const bool bShouldTick{ TickReasons != EEnemyTickReason::ETR_None };
+	if (bShouldTick == IsActorTickEnabled()) return;
+
+	SetActorTickEnabled(bShouldTick);
+	if (bShouldTick)
+	{
+		INC_DWORD_STAT(STAT_TickingEnemies);
+		DEC_DWORD_STAT(STAT_DormantEnemies);
+	}
+	else
+	{
+		DEC_DWORD_STAT(STAT_TickingEnemies);
+		INC_DWORD_STAT(STAT_DormantEnemies);
+	}
+}
+
 // Called every frame
 void AEnemy::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	UpdateHitNumbers();
 }
 
 // Called to bind functionality to input
@@ -474,36 +661,44 @@ void AEnemy::BulletHit_Implementation(FHitResult HitResult, AActor* Shooter, ACo
 {
 	if (ImpactSound)
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, ImpactSound, GetActorLocation());
+		UShooterAudioSubsystem::PlaySoundAtLocation(GetWorld(), ImpactSound, GetActorLocation());
 	}
 	if (ImpactParticles)
 	{
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ImpactParticles, HitResult.Location, FRotator(0.f), true);
+		UEffectsPoolSubsystem::PlayEffect(GetWorld(), ImpactParticles, FTransform(HitResult.Location));
 	}
 }
 
 float AEnemy::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
 {
+	SHOOTER_SCOPE_CYCLE_COUNTER(EnemyTakeDamage);
+	ShooterCounters::NumDamageEvents.fetch_add(1, std::memory_order_relaxed);
+
 	// Set the Target Blackboard Ket to agro the Character (Dman mermi yedii zaman bize doru geliyor)
 	if (EnemyController)
 	{
-		EnemyController->GetBlackboardComponent()->SetValueAsObject(
-			FName("Target"),
-			DamageCauser
-		);
+		EnemyController->SetBlackboardObject(
+			EEnemyBlackboardKey::EBK_Target,
+			DamageCauser);
+	}
+	if (DamageCauser && !bHasTarget)
+	{
+		bHasTarget = true;
+		RefreshSignificance();
 	}
 
-	if (Health - DamageAmount <= 0.f)
+	const float NewHealth{ GetHealth() - DamageAmount };
+	if (NewHealth <= 0.f)
 	{
-		Health = 0.f;
+		SetHealth(0.f);
 		Die();
 	}
 	else 
 	{
-		Health -= DamageAmount;
+		SetHealth(NewHealth);
 	}
 
-	if (bDying) return DamageAmount;
+	if (IsDying()) return DamageAmount;
 
 	ShowHealthBar();
 
@@ -5,8 +5,18 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "BulletHitInterface.h"
+#include "EnemyStateSubsystem.h"
 #include "Enemy.generated.h"
 
+/** Reasons an enemy needs its actor tick; the tick is only enabled while at least one is set */
+enum class EEnemyTickReason : uint8
+{
+	ETR_None = 0,
+	ETR_Blueprint = 1 << 0,		// The Blueprint implements Event Tick
+	ETR_ForceTick = 1 << 1		// shooter.Enemy.ForceTick is set
+};
+ENUM_CLASS_FLAGS(EEnemyTickReason);
+
 UCLASS()
 class SHOOTER_API AEnemy : public ACharacter, public IBulletHitInterface
 {
@@ -20,6 +30,14 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Enable the actor tick only while there are tick reasons*/
+	void UpdateActorTick();
+
+	/** Have UEnemySignificanceSubsystem score this enemy again now*/
+	void RefreshSignificance();
+
 	UFUNCTION(BlueprintNativeEvent)
 	void ShowHealthBar();
 	void ShowHealthBar_Implementation();
@@ -33,14 +51,6 @@ protected:
 
 	void ResetHitReactTimer();
 
-	UFUNCTION(BlueprintCallable)
-	void StoreHitNumber(UUserWidget* HitNumber, FVector Location);
-
-	UFUNCTION()
-	void DestroyHitNumber(UUserWidget* HitNumber);
-
-	void UpdateHitNumbers();
-
 	/** Called when smth overlaps with the agro sphere*/
 	UFUNCTION()
 	void AgroSphereOverlap(
@@ -128,11 +138,7 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
 	class USoundCue* ImpactSound;
 
-	/** Current health of the enemy*/
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = true))
-	float Health;
-
-	/** Max Health of the enemy*/
+	/** Max Health of the enemy, and its health when spawned. Current health is read with GetHealth*/
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
 	float MaxHealth;
 
@@ -144,25 +150,28 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
 	float HealthBarDisplayTime;
 
-	FTimerHandle HealthBarTimer;
+	/** Health bar, hit react and attack wait cooldowns*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = true))
+	class UCooldownComponent* Cooldowns;
+
+	/** Slots in Cooldowns*/
+	int32 HealthBarCooldown;
+	int32 HitReactCooldown;
+	int32 AttackWaitCooldown;
 
 	/** Montage containing Hit and Death animations*/
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
 	UAnimMontage* HitMontage;
 
-	FTimerHandle HitReactTimer;
-
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
 	float HitReactTimeMin;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
 	float HitReactTimeMax;
 
-	bool bCanHitReact;
-
-	/** Map tto store the hit number widgets and their hit locations*/
-	UPROPERTY(VisibleAnywhere, Category = Combat, meta = (AllowPrivateAccess = true))
-	TMap<UUserWidget*, FVector> HitNumbers;
+	/** Widget class for the hit numbers; the widgets themselves are pooled by UHitNumberSubsystem*/
+	UPROPERTY(EditAnywhere, Category = Combat, meta = (AllowPrivateAccess = true))
+	TSubclassOf<class UHitNumberWidget> HitNumberWidgetClass;
 
 	/** Time before a HitNumber is removed from the screen*/
 	UPROPERTY(EditAnywhere, Category = Combat, meta = (AllowPrivateAccess = true))
@@ -186,18 +195,10 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
 	class USphereComponent* AgroSphere;
 
-	/** True when playing the get hit animation*/
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
-	bool bStunned;
-
 	/** Chance of being stunned 0: no stun chance 1: %100 stun chance*/
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
 	float StunChance;
 
-	/** True when  character in the attack range that means time to attack*/
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
-	bool bInAttackRange;
-
 	/** Sphere for attack range*/
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
 	USphereComponent* CombatRangeSphere;
@@ -230,12 +231,6 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
 	FName RightWeaponSocket;
 
-	/** true when enemey can attack */
-	UPROPERTY(VisibleAnywhere, Category = Combat, meta = (AllowPrivateAccess = true));
-	bool bCanAttack;
-
-	FTimerHandle AttackWaitTimer;
-
 	/** Minimum wait time between attacks*/
 	UPROPERTY(EditAnywhere, Category = Combat, meta = (AllowPrivateAccess = true))
 	float AttackWaitTime;
@@ -244,17 +239,37 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
 	UAnimMontage* DeathMontage;
 
-	bool bDying;
-
 	FTimerHandle DeathTimer;
 	
 	/** Time after death until Destroy*/
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
 	float DeathTime;
+
+	/** Why this enemy currently needs to tick*/
+	EEnemyTickReason TickReasons;
+
+	/** True once the Target blackboard key has been set*/
+	bool bHasTarget;
+
+	/** Store holding this enemy's health and combat flags, and our entry in it*/
+	UPROPERTY()
+	UEnemyStateSubsystem* EnemyState;
+	FEnemyStateHandle StateHandle;
+
+	/** Health and combat flags while not registered with EnemyState*/
+	FEnemyStateEntry LocalState;
+
+	bool HasStateFlags(EEnemyStateFlags Flags) const;
+	void SetStateFlags(EEnemyStateFlags Flags, bool bValue);
+
+	void SetHealth(float NewHealth);
 public:	
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 
+	void AddTickReason(EEnemyTickReason Reason);
+	void RemoveTickReason(EEnemyTickReason Reason);
+
 	// Called to bind functionality to input
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
@@ -264,8 +279,38 @@ public:
 
 	FORCEINLINE FString GetHeadBone() const { return HeadBone; }
 
-	UFUNCTION(BlueprintImplementableEvent)
+	/** Shows a pooled number through UHitNumberSubsystem. Blueprints that still override it and create
+	 *  their own widget can hand it to StoreHitNumber, as before*/
+	UFUNCTION(BlueprintNativeEvent)
 	void ShowHitNumber(int32 Damage, FVector HitLocation,bool bHeadShot);
+	void ShowHitNumber_Implementation(int32 Damage, FVector HitLocation, bool bHeadShot);
+
+	/** Keep a Blueprint-created hit number over Location until HitNumberDestroyTime has passed*/
+	UFUNCTION(BlueprintCallable)
+	void StoreHitNumber(UUserWidget* HitNumber, FVector Location);
 
 	FORCEINLINE UBehaviorTree* GetBehaviorTree() const { return BehaviorTree; }
+	FORCEINLINE bool HasTarget() const { return bHasTarget; }
+
+	/** Actor in the Target blackboard key, if any */
+	AActor* GetTarget() const;
+
+	/** Clear the Target blackboard key once the target is dead or gone */
+	void LoseTarget();
+
+	/** True when a character is in the attack range, which means time to attack*/
+	UFUNCTION(BlueprintPure)
+	bool IsInAttackRange() const { return HasStateFlags(EEnemyStateFlags::ESF_InAttackRange); }
+
+	/** True when playing the get hit animation*/
+	UFUNCTION(BlueprintPure)
+	bool IsStunned() const { return HasStateFlags(EEnemyStateFlags::ESF_Stunned); }
+
+	UFUNCTION(BlueprintPure)
+	bool IsDying() const { return HasStateFlags(EEnemyStateFlags::ESF_Dying); }
+
+	UFUNCTION(BlueprintPure)
+	float GetHealth() const;
+
+	FORCEINLINE float GetMaxHealth() const { return MaxHealth; }
 };
@@ -5,7 +5,27 @@
 #include "BehaviorTree/BlackboardComponent.h"
 #include "BehaviorTree/BehaviorTreeComponent.h"
 #include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
 #include "Enemy.h"
+#include "ShooterStats.h"
+
+namespace
+{
+	/** Key names in EEnemyBlackboardKey order */
+	const TCHAR* BlackboardKeyNames[]{
+		TEXT("CanAttack"),
+		TEXT("Target"),
+		TEXT("InAttackRange"),
+		TEXT("Stunned"),
+		TEXT("Dead"),
+		TEXT("PatrolPoint"),
+		TEXT("PatrolPoint2"),
+		TEXT("CharacterDead")
+	};
+	static_assert(UE_ARRAY_COUNT(BlackboardKeyNames) == static_cast<int32>(EEnemyBlackboardKey::EBK_MAX), "BlackboardKeyNames must match EEnemyBlackboardKey");
+}
 
 AEnemyController::AEnemyController()
 {
@@ -15,6 +35,10 @@ AEnemyController::AEnemyController()
 	BehaviorTreeComponent = CreateDefaultSubobject<UBehaviorTreeComponent>(TEXT("BehaviorTreeComponent"));
 	check(BehaviorTreeComponent);
 
+	for (FBlackboard::FKey& Key : BlackboardKeys)
+	{
+		Key = FBlackboard::InvalidKey;
+	}
 }
 void AEnemyController::OnPossess(APawn* InPawn)
 {
@@ -27,7 +51,53 @@ void AEnemyController::OnPossess(APawn* InPawn)
 		if (Enemy->GetBehaviorTree())
 		{
 			BlackboardComponent->InitializeBlackboard(*(Enemy->GetBehaviorTree()->BlackboardAsset));
-		
+			ResolveBlackboardKeys();
 		}
 	}
 }
+
+void AEnemyController::ResolveBlackboardKeys()
+{
+	for (int32 i = 0; i < BlackboardKeys.Num(); i++)
+	{
+		BlackboardKeys[i] = BlackboardComponent->GetKeyID(FName(BlackboardKeyNames[i]));
+	}
+}
+
+void AEnemyController::SetBlackboardBool(EEnemyBlackboardKey Key, bool bValue)
+{
+	const FBlackboard::FKey KeyID{ BlackboardKeys[static_cast<int32>(Key)] };
+	if (KeyID != FBlackboard::InvalidKey)
+	{
+		SHOOTER_INC_COUNTER(BlackboardWrites);
+		BlackboardComponent->SetValue<UBlackboardKeyType_Bool>(KeyID, bValue);
+	}
+}
+
+void AEnemyController::SetBlackboardObject(EEnemyBlackboardKey Key, UObject* Value)
+{
+	const FBlackboard::FKey KeyID{ BlackboardKeys[static_cast<int32>(Key)] };
+	if (KeyID != FBlackboard::InvalidKey)
+	{
+		SHOOTER_INC_COUNTER(BlackboardWrites);
+		BlackboardComponent->SetValue<UBlackboardKeyType_Object>(KeyID, Value);
+	}
+}
+
+UObject* AEnemyController::GetBlackboardObject(EEnemyBlackboardKey Key) const
+{
+	const FBlackboard::FKey KeyID{ BlackboardKeys[static_cast<int32>(Key)] };
+	if (KeyID == FBlackboard::InvalidKey) return nullptr;
+
+	return BlackboardComponent->GetValue<UBlackboardKeyType_Object>(KeyID);
+}
+
+void AEnemyController::SetBlackboardVector(EEnemyBlackboardKey Key, const FVector& Value)
+{
+	const FBlackboard::FKey KeyID{ BlackboardKeys[static_cast<int32>(Key)] };
+	if (KeyID != FBlackboard::InvalidKey)
+	{
+		SHOOTER_INC_COUNTER(BlackboardWrites);
+		BlackboardComponent->SetValue<UBlackboardKeyType_Vector>(KeyID, Value);
+	}
+}
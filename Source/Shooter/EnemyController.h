@@ -4,8 +4,25 @@
 
 #include "CoreMinimal.h"
 #include "AIController.h"
+#include "BehaviorTree/BehaviorTreeTypes.h"
+#include "Containers/StaticArray.h"
 #include "EnemyController.generated.h"
 
+/** Blackboard keys written from C++; their IDs are resolved once in AEnemyController::OnPossess */
+enum class EEnemyBlackboardKey : uint8
+{
+	EBK_CanAttack,
+	EBK_Target,
+	EBK_InAttackRange,
+	EBK_Stunned,
+	EBK_Dead,
+	EBK_PatrolPoint,
+	EBK_PatrolPoint2,
+	EBK_CharacterDead,
+
+	EBK_MAX
+};
+
 /**
  * 
  */
@@ -16,8 +33,19 @@ class SHOOTER_API AEnemyController : public AAIController
 public:
 	AEnemyController();
 	virtual void OnPossess(APawn* InPawn) override;
+
+	/** Write a blackboard value through the cached key ID */
+	void SetBlackboardBool(EEnemyBlackboardKey Key, bool bValue);
+	void SetBlackboardObject(EEnemyBlackboardKey Key, UObject* Value);
+	void SetBlackboardVector(EEnemyBlackboardKey Key, const FVector& Value);
+
+	/** Read an object key through the cached key ID; nullptr if the asset doesn't have the key */
+	UObject* GetBlackboardObject(EEnemyBlackboardKey Key) const;
 	
 private:
+	/** Look up the ID of every EEnemyBlackboardKey in the current blackboard asset */
+	void ResolveBlackboardKeys();
+
 	/** Blackboard component for this enemy*/
 	UPROPERTY(BlueprintReadWrite, Category = "AI Behavior", meta = (AllowPrivateAccess = "true"))
 	class UBlackboardComponent* BlackboardComponent;
@@ -25,6 +53,9 @@ private:
 	/** Behavior tree component for this enemy*/
 	UPROPERTY(BlueprintReadWrite, Category = "AI Behavior", meta = (AllowPrivateAccess = "true"))
 	class UBehaviorTreeComponent* BehaviorTreeComponent;
+
+	/** Key IDs indexed by EEnemyBlackboardKey; InvalidKey if the asset doesn't have the key */
+	TStaticArray<FBlackboard::FKey, static_cast<int32>(EEnemyBlackboardKey::EBK_MAX)> BlackboardKeys;
 public:
 	
 	FORCEINLINE UBlackboardComponent* GetBlackboardComponent() const { return BlackboardComponent; }
@@ -0,0 +1,236 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemySignificanceSubsystem.h"
+#include "Enemy.h"
+#include "ShooterCharacter.h"
+#include "ShooterStats.h"
+#include "GruxAnimInstance.h"
+#include "AIController.h"
+#include "BrainComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+
+namespace
+{
+	/** False once the target has died or been destroyed */
+	bool IsTargetAlive(const AActor* Target)
+	{
+		if (!IsValid(Target)) return false;
+
+		const AShooterCharacter* Character{ Cast<AShooterCharacter>(Target) };
+		return Character == nullptr || !Character->IsDead();
+	}
+}
+
+UEnemySignificanceSubsystem::UEnemySignificanceSubsystem() :
+	EnemiesPerUpdate(32),
+	LineOfSightTracesPerUpdate(8),
+	LineOfSightTracesLeft(0),
+	NextEnemy(0)
+{
+	// Full fidelity
+	FEnemySignificanceTier& Full{ Tiers.AddDefaulted_GetRef() };
+	Full.MaxDistance = 2'000.f;
+
+	// Mid range: movement and animation at 30 Hz, behavior tree at 10 Hz
+	FEnemySignificanceTier& Reduced{ Tiers.AddDefaulted_GetRef() };
+	Reduced.MaxDistance = 5'000.f;
+	Reduced.ActorTickInterval = 0.1f;
+	Reduced.BehaviorTreeTickInterval = 0.1f;
+	Reduced.MeshTickInterval = 1.f / 30.f;
+	Reduced.MovementTickInterval = 1.f / 30.f;
+
+	// Far or out of sight: no pose when not rendered, everything else at a few Hz
+	FEnemySignificanceTier& Low{ Tiers.AddDefaulted_GetRef() };
+	Low.ActorTickInterval = 0.5f;
+	Low.BehaviorTreeTickInterval = 0.25f;
+	Low.MeshTickInterval = 0.1f;
+	Low.MovementTickInterval = 0.1f;
+	Low.VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+}
+
+void UEnemySignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	FPlayerView PlayerView;
+	const bool bHasPlayer{ GetPlayerView(PlayerView) };
+	LineOfSightTracesLeft = LineOfSightTracesPerUpdate;
+
+	const int32 NumToUpdate{ FMath::Min(EnemiesPerUpdate, Enemies.Num()) };
+	for (int32 i = 0; i < NumToUpdate; i++)
+	{
+		if (NextEnemy >= Enemies.Num())
+		{
+			NextEnemy = 0;
+		}
+		UpdateEnemy(NextEnemy++, bHasPlayer ? &PlayerView : nullptr);
+	}
+}
+
+TStatId UEnemySignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemySignificanceSubsystem, STATGROUP_Tickables);
+}
+
+bool UEnemySignificanceSubsystem::IsTickable() const
+{
+	return Enemies.Num() > 0 && Tiers.Num() > 0;
+}
+
+bool UEnemySignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEnemySignificanceSubsystem::RegisterEnemy(AEnemy* Enemy)
+{
+	if (Enemy == nullptr || EnemyIndices.Contains(Enemy)) return;
+
+	EnemyIndices.Add(Enemy, Enemies.Add(Enemy));
+	EnemyTiers.Add(INDEX_NONE);
+	EnemyLineOfSight.Add(true);
+}
+
+void UEnemySignificanceSubsystem::UnregisterEnemy(AEnemy* Enemy)
+{
+	int32 Index;
+	if (!EnemyIndices.RemoveAndCopyValue(Enemy, Index)) return;
+
+	Enemies.RemoveAtSwap(Index, 1, false);
+	EnemyTiers.RemoveAtSwap(Index, 1, false);
+	EnemyLineOfSight.RemoveAtSwap(Index, 1, false);
+
+	// The last enemy moved into the freed slot
+	if (Enemies.IsValidIndex(Index) && Enemies[Index])
+	{
+		EnemyIndices.Add(Enemies[Index], Index);
+	}
+}
+
+void UEnemySignificanceSubsystem::RefreshEnemy(AEnemy* Enemy)
+{
+	const int32* Index{ EnemyIndices.Find(Enemy) };
+	if (Index == nullptr || Tiers.Num() == 0) return;
+
+	FPlayerView PlayerView;
+	const bool bHasPlayer{ GetPlayerView(PlayerView) };
+	UpdateEnemy(*Index, bHasPlayer ? &PlayerView : nullptr);
+}
+
+int32 UEnemySignificanceSubsystem::GetEnemyTier(const AEnemy* Enemy) const
+{
+	const int32* Index{ EnemyIndices.Find(Enemy) };
+	return Index ? EnemyTiers[*Index] : INDEX_NONE;
+}
+
+void UEnemySignificanceSubsystem::UpdateEnemy(int32 Index, const FPlayerView* PlayerView)
+{
+	AEnemy* Enemy{ Enemies[Index] };
+	if (!IsValid(Enemy)) return;
+
+	// LoseTarget scores the enemy again
+	if (Enemy->HasTarget() && !IsTargetAlive(Enemy->GetTarget()))
+	{
+		Enemy->LoseTarget();
+		return;
+	}
+
+	const int32 Tier{ ScoreEnemy(Index, PlayerView) };
+	if (Tier != EnemyTiers[Index])
+	{
+		ApplyTier(Enemy, Tier);
+		EnemyTiers[Index] = Tier;
+	}
+}
+
+int32 UEnemySignificanceSubsystem::ScoreEnemy(int32 Index, const FPlayerView* PlayerView)
+{
+	const AEnemy* Enemy{ Enemies[Index] };
+	const int32 LowestTier{ Tiers.Num() - 1 };
+
+	// Engaged enemies always get full fidelity
+	if (Enemy->HasTarget() || Enemy->IsInAttackRange()) return 0;
+	if (PlayerView == nullptr) return LowestTier;
+
+	const double DistanceSquared{ FVector::DistSquared(Enemy->GetActorLocation(), PlayerView->Location) };
+	int32 Tier{ LowestTier };
+	for (int32 i = 0; i < LowestTier; i++)
+	{
+		if (DistanceSquared <= FMath::Square(Tiers[i].MaxDistance))
+		{
+			Tier = i;
+			break;
+		}
+	}
+
+	// Enemies the player can't see drop a tier. Only rendered ones are worth a trace
+	if (!Enemy->WasRecentlyRendered(0.2f) || !HasLineOfSight(Index, *PlayerView))
+	{
+		Tier = FMath::Min(Tier + 1, LowestTier);
+	}
+	return Tier;
+}
+
+bool UEnemySignificanceSubsystem::HasLineOfSight(int32 Index, const FPlayerView& PlayerView)
+{
+	if (LineOfSightTracesLeft <= 0) return EnemyLineOfSight[Index];
+	LineOfSightTracesLeft--;
+
+	const AEnemy* Enemy{ Enemies[Index] };
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(EnemySignificanceLineOfSight));
+	QueryParams.AddIgnoredActor(PlayerView.Pawn);
+	QueryParams.AddIgnoredActor(Enemy);
+
+	SHOOTER_COUNT_TRACE();
+	EnemyLineOfSight[Index] = !GetWorld()->LineTraceTestByChannel(PlayerView.ViewLocation, Enemy->GetActorLocation(), ECollisionChannel::ECC_Visibility, QueryParams);
+	return EnemyLineOfSight[Index];
+}
+
+void UEnemySignificanceSubsystem::ApplyTier(AEnemy* Enemy, int32 Tier) const
+{
+	const FEnemySignificanceTier& Settings{ Tiers[Tier] };
+
+	Enemy->SetActorTickInterval(Settings.ActorTickInterval);
+
+	USkeletalMeshComponent* Mesh{ Enemy->GetMesh() };
+	if (Mesh)
+	{
+		Mesh->SetComponentTickInterval(Settings.MeshTickInterval);
+
+		// Never relax what the anim instance asks for, e.g. skipping updates off screen
+		EVisibilityBasedAnimTickOption TickOption{ Settings.VisibilityBasedAnimTickOption };
+		if (const UGruxAnimInstance* GruxAnimInstance{ Cast<UGruxAnimInstance>(Mesh->GetAnimInstance()) })
+		{
+			TickOption = UGruxAnimInstance::GetMoreAggressiveTickOption(TickOption, GruxAnimInstance->GetMinVisibilityBasedAnimTickOption());
+		}
+		Mesh->VisibilityBasedAnimTickOption = TickOption;
+	}
+
+	UCharacterMovementComponent* Movement{ Enemy->GetCharacterMovement() };
+	if (Movement)
+	{
+		Movement->SetComponentTickInterval(Settings.MovementTickInterval);
+	}
+
+	const AAIController* AIController{ Cast<AAIController>(Enemy->GetController()) };
+	UBrainComponent* Brain{ AIController ? AIController->GetBrainComponent() : nullptr };
+	if (Brain)
+	{
+		Brain->SetComponentTickInterval(Settings.BehaviorTreeTickInterval);
+	}
+}
+
+bool UEnemySignificanceSubsystem::GetPlayerView(FPlayerView& OutView) const
+{
+	const APlayerController* PlayerController{ GetWorld()->GetFirstPlayerController() };
+	const APawn* PlayerPawn{ PlayerController ? PlayerController->GetPawn() : nullptr };
+	if (PlayerPawn == nullptr) return false;
+
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(OutView.ViewLocation, ViewRotation);
+	OutView.Location = PlayerPawn->GetActorLocation();
+	OutView.Pawn = PlayerPawn;
+	return true;
+}
@@ -0,0 +1,124 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "UObject/ObjectKey.h"
+#include "EnemySignificanceSubsystem.generated.h"
+
+class AEnemy;
+
+USTRUCT(BlueprintType)
+struct FEnemySignificanceTier
+{
+	GENERATED_BODY()
+
+	/** Enemies within this distance of the player use this tier; ignored for the last tier */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float MaxDistance{ 0.f };
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float ActorTickInterval{ 0.f };
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float BehaviorTreeTickInterval{ 0.f };
+
+	/** Animation update interval */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float MeshTickInterval{ 0.f };
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float MovementTickInterval{ 0.f };
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	EVisibilityBasedAnimTickOption VisibilityBasedAnimTickOption{ EVisibilityBasedAnimTickOption::AlwaysTickPose };
+};
+
+/**
+ * Scores every enemy by distance and visibility to the player and puts it in a fidelity tier.
+ * Lower tiers tick the actor, behavior tree, animation and movement less often.
+ * Enemies with a target or the player in attack range always use the first (full fidelity) tier.
+ * Visibility is whether the enemy was rendered and, throttled to a few traces per frame, whether the
+ * player's view has line of sight to it.
+ */
+UCLASS(Config = Game)
+class SHOOTER_API UEnemySignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UEnemySignificanceSubsystem();
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override;
+
+	void RegisterEnemy(AEnemy* Enemy);
+	void UnregisterEnemy(AEnemy* Enemy);
+
+	/** Score one enemy right away, e.g. when it picks up a target */
+	void RefreshEnemy(AEnemy* Enemy);
+
+	/** Current tier of the enemy, or INDEX_NONE if it isn't registered */
+	int32 GetEnemyTier(const AEnemy* Enemy) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FPlayerView
+	{
+		/** Location of the player's pawn */
+		FVector Location;
+
+		/** Camera location, where line of sight is traced from */
+		FVector ViewLocation;
+
+		const AActor* Pawn{ nullptr };
+	};
+
+	/** Score the enemy at Index and apply its tier if it changed */
+	void UpdateEnemy(int32 Index, const FPlayerView* PlayerView);
+
+	int32 ScoreEnemy(int32 Index, const FPlayerView* PlayerView);
+
+	/** Trace from the player's view to the enemy, or reuse the last result once this frame's traces are spent */
+	bool HasLineOfSight(int32 Index, const FPlayerView& PlayerView);
+
+	void ApplyTier(AEnemy* Enemy, int32 Tier) const;
+
+	/** The player's pawn and camera; false if there isn't a pawn */
+	bool GetPlayerView(FPlayerView& OutView) const;
+
+	/** Tiers from full fidelity down */
+	UPROPERTY(Config, EditAnywhere, Category = Significance)
+	TArray<FEnemySignificanceTier> Tiers;
+
+	/** Number of enemies scored per frame, round robin */
+	UPROPERTY(Config, EditAnywhere, Category = Significance)
+	int32 EnemiesPerUpdate;
+
+	/** Line of sight traces per frame; enemies scored after that reuse their last result */
+	UPROPERTY(Config, EditAnywhere, Category = Significance)
+	int32 LineOfSightTracesPerUpdate;
+
+	UPROPERTY()
+	TArray<AEnemy*> Enemies;
+
+	/** Index of each registered enemy in Enemies */
+	TMap<FObjectKey, int32> EnemyIndices;
+
+	/** Tier applied to each entry in Enemies; INDEX_NONE until first scored */
+	TArray<int32> EnemyTiers;
+
+	/** Result of the last line of sight trace to each entry in Enemies */
+	TArray<bool> EnemyLineOfSight;
+
+	/** Line of sight traces still allowed this frame */
+	int32 LineOfSightTracesLeft;
+
+	/** Next enemy to score */
+	int32 NextEnemy;
+};
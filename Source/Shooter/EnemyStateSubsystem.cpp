@@ -0,0 +1,136 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemyStateSubsystem.h"
+#include "Enemy.h"
+
+bool UEnemyStateSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FEnemyStateHandle UEnemyStateSubsystem::AddEnemy(AEnemy* Enemy, const FEnemyStateEntry& Entry)
+{
+	int32 Slot;
+	if (FreeSlots.Num() > 0)
+	{
+		Slot = FreeSlots.Pop(false);
+	}
+	else
+	{
+		Slot = Slots.AddDefaulted();
+	}
+
+	const int32 Index{ Enemies.Add(Enemy) };
+	IndexToSlot.Add(Slot);
+	Healths.Add(Entry.Health);
+	Flags.Add(Entry.Flags);
+
+	Slots[Slot].Index = Index;
+
+	FEnemyStateHandle Handle;
+	Handle.Slot = Slot;
+	Handle.Generation = Slots[Slot].Generation;
+	return Handle;
+}
+
+FEnemyStateEntry UEnemyStateSubsystem::RemoveEnemy(FEnemyStateHandle& Handle)
+{
+	const int32 Index{ GetIndex(Handle) };
+	Handle = FEnemyStateHandle();
+	if (Index == INDEX_NONE) return FEnemyStateEntry();
+
+	FEnemyStateEntry Entry;
+	Entry.Health = Healths[Index];
+	Entry.Flags = Flags[Index];
+
+	// The last entry moves into the hole; point its slot at the new index
+	const int32 LastIndex{ Enemies.Num() - 1 };
+	if (Index != LastIndex)
+	{
+		Slots[IndexToSlot[LastIndex]].Index = Index;
+	}
+
+	FSlot& Slot{ Slots[IndexToSlot[Index]] };
+	Slot.Index = INDEX_NONE;
+	Slot.Generation++;
+	FreeSlots.Add(IndexToSlot[Index]);
+
+	Enemies.RemoveAtSwap(Index, 1, false);
+	IndexToSlot.RemoveAtSwap(Index, 1, false);
+	Healths.RemoveAtSwap(Index, 1, false);
+	Flags.RemoveAtSwap(Index, 1, false);
+	return Entry;
+}
+
+bool UEnemyStateSubsystem::IsValid(FEnemyStateHandle Handle) const
+{
+	return GetIndex(Handle) != INDEX_NONE;
+}
+
+int32 UEnemyStateSubsystem::GetIndex(FEnemyStateHandle Handle) const
+{
+	if (!Slots.IsValidIndex(Handle.Slot)) return INDEX_NONE;
+
+	const FSlot& Slot{ Slots[Handle.Slot] };
+	return Slot.Generation == Handle.Generation ? Slot.Index : INDEX_NONE;
+}
+
+float UEnemyStateSubsystem::GetHealth(FEnemyStateHandle Handle) const
+{
+	const int32 Index{ GetIndex(Handle) };
+	return Index != INDEX_NONE ? Healths[Index] : 0.f;
+}
+
+void UEnemyStateSubsystem::SetHealth(FEnemyStateHandle Handle, float Health)
+{
+	const int32 Index{ GetIndex(Handle) };
+	if (Index != INDEX_NONE)
+	{
+		Healths[Index] = Health;
+	}
+}
+
+bool UEnemyStateSubsystem::HasAnyFlags(FEnemyStateHandle Handle, EEnemyStateFlags InFlags) const
+{
+	const int32 Index{ GetIndex(Handle) };
+	return Index != INDEX_NONE && EnumHasAnyFlags(Flags[Index], InFlags);
+}
+
+void UEnemyStateSubsystem::SetFlags(FEnemyStateHandle Handle, EEnemyStateFlags InFlags, bool bValue)
+{
+	const int32 Index{ GetIndex(Handle) };
+	if (Index == INDEX_NONE) return;
+
+	if (bValue)
+	{
+		Flags[Index] |= InFlags;
+	}
+	else
+	{
+		Flags[Index] &= ~InFlags;
+	}
+}
+
+void UEnemyStateSubsystem::GatherEnemiesWithAnyFlags(EEnemyStateFlags InFlags, TArray<AEnemy*>& OutEnemies) const
+{
+	for (int32 i = 0; i < Flags.Num(); i++)
+	{
+		if (EnumHasAnyFlags(Flags[i], InFlags))
+		{
+			OutEnemies.Add(Enemies[i]);
+		}
+	}
+}
+
+int32 UEnemyStateSubsystem::CountEnemiesWithAnyFlags(EEnemyStateFlags InFlags) const
+{
+	// Branch free so the compiler can vectorize the scan
+	const uint8 Mask{ static_cast<uint8>(InFlags) };
+	int32 Count{ 0 };
+	for (const EEnemyStateFlags EnemyFlags : Flags)
+	{
+		Count += (static_cast<uint8>(EnemyFlags) & Mask) != 0;
+	}
+	return Count;
+}
@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyStateSubsystem.generated.h"
+
+class AEnemy;
+
+/** Combat flags for one enemy, packed into a byte per enemy */
+enum class EEnemyStateFlags : uint8
+{
+	ESF_None = 0,
+	ESF_Stunned = 1 << 0,		// Playing the hit react after a stun roll
+	ESF_Dying = 1 << 1,			// Health reached zero
+	ESF_CanAttack = 1 << 2,		// Attack wait time has passed
+	ESF_CanHitReact = 1 << 3,	// Hit react wait time has passed
+	ESF_InAttackRange = 1 << 4	// A character is inside the combat range sphere
+};
+ENUM_CLASS_FLAGS(EEnemyStateFlags);
+
+/** One enemy's health and flags, as kept by the enemy itself in worlds without a UEnemyStateSubsystem */
+struct FEnemyStateEntry
+{
+	float Health{ 0.f };
+	EEnemyStateFlags Flags{ EEnemyStateFlags::ESF_None };
+};
+
+/** Stable reference to an enemy's entry; stays valid while other enemies are added and removed */
+struct FEnemyStateHandle
+{
+	int32 Slot{ INDEX_NONE };
+	uint32 Generation{ 0 };
+
+	FORCEINLINE bool IsSet() const { return Slot != INDEX_NONE; }
+};
+
+/**
+ * Combat state of every enemy in the world, stored as parallel arrays (struct of arrays).
+ * AEnemy reads and writes its own entry through an FEnemyStateHandle. Passes over many enemies
+ * ("which are dead, stunned or in range") read the packed arrays directly instead of
+ * touching each actor. Entries are swap-removed, so the arrays stay dense.
+ */
+UCLASS()
+class SHOOTER_API UEnemyStateSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	FEnemyStateHandle AddEnemy(AEnemy* Enemy, const FEnemyStateEntry& Entry);
+
+	/** Remove the entry, returning its last state */
+	FEnemyStateEntry RemoveEnemy(FEnemyStateHandle& Handle);
+
+	/** True if the handle still refers to a live entry */
+	bool IsValid(FEnemyStateHandle Handle) const;
+
+	float GetHealth(FEnemyStateHandle Handle) const;
+	void SetHealth(FEnemyStateHandle Handle, float Health);
+
+	bool HasAnyFlags(FEnemyStateHandle Handle, EEnemyStateFlags Flags) const;
+	void SetFlags(FEnemyStateHandle Handle, EEnemyStateFlags Flags, bool bValue);
+
+	/** Append every enemy that has any of Flags set */
+	void GatherEnemiesWithAnyFlags(EEnemyStateFlags Flags, TArray<AEnemy*>& OutEnemies) const;
+
+	/** Number of enemies that have any of Flags set */
+	int32 CountEnemiesWithAnyFlags(EEnemyStateFlags Flags) const;
+
+	/** Packed arrays, all Num() long and in the same order, for passes over every enemy */
+	FORCEINLINE int32 Num() const { return Enemies.Num(); }
+	FORCEINLINE TConstArrayView<AEnemy*> GetEnemies() const { return Enemies; }
+	FORCEINLINE TConstArrayView<float> GetHealths() const { return Healths; }
+	FORCEINLINE TConstArrayView<EEnemyStateFlags> GetFlags() const { return Flags; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Dense index of a live handle, INDEX_NONE for a stale one */
+	int32 GetIndex(FEnemyStateHandle Handle) const;
+
+	/** Dense index per handle slot, and the generation that slot is on */
+	struct FSlot
+	{
+		int32 Index{ INDEX_NONE };
+		uint32 Generation{ 0 };
+	};
+	TArray<FSlot> Slots;
+	TArray<int32> FreeSlots;
+
+	/** Packed per-enemy state */
+	UPROPERTY()
+	TArray<AEnemy*> Enemies;
+	TArray<int32> IndexToSlot;
+	TArray<float> Healths;
+	TArray<EEnemyStateFlags> Flags;
+};
@@ -7,11 +7,19 @@
 #include "Particles/ParticleSystem.h"
 #include "Components/SphereComponent.h"
 #include "GameFramework/Character.h"
-#include "Kismet/GameplayStatics.h"
+#include "Components/CapsuleComponent.h"
+#include "ShooterStats.h"
+#include "DamagePipelineSubsystem.h"
+#include "CharacterGridSubsystem.h"
+#include "DetonationSubsystem.h"
+#include "ShooterAudioSubsystem.h"
 
 // Sets default values
 AExplosive::AExplosive() :
-	Damage(100.f)
+	Damage(100.f),
+	DamageInnerRadius(100.f),
+	MinimumDamage(20.f),
+	ChainReactionRadius(0.f)
 {
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
@@ -21,6 +29,9 @@ AExplosive::AExplosive() :
 
 	OverlapSphere = CreateDefaultSubobject<USphereComponent>(TEXT("OverlapSphere"));
 	OverlapSphere->SetupAttachment(GetRootComponent());
+	// Only defines the blast radius; idle explosives shouldn't pay for overlap updates
+	OverlapSphere->SetGenerateOverlapEvents(false);
+	OverlapSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 }
 
 // Called when the game starts or when spawned
@@ -28,6 +39,22 @@ void AExplosive::BeginPlay()
 {
 	Super::BeginPlay();
 	
+	UDetonationSubsystem* DetonationSubsystem{ GetWorld()->GetSubsystem<UDetonationSubsystem>() };
+	if (DetonationSubsystem)
+	{
+		DetonationSubsystem->RegisterExplosive(this);
+	}
+}
+
+void AExplosive::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UDetonationSubsystem* DetonationSubsystem{ GetWorld()->GetSubsystem<UDetonationSubsystem>() };
+	if (DetonationSubsystem)
+	{
+		DetonationSubsystem->UnregisterExplosive(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // Called every frame
@@ -39,28 +66,117 @@ void AExplosive::Tick(float DeltaTime)
 
 void AExplosive::BulletHit_Implementation(FHitResult HitResult, AActor* Shooter, AController* ShooterController)
 {
+	// Detonates with the rest of this frame's explosions, within budget
+	UDetonationSubsystem* DetonationSubsystem{ GetWorld()->GetSubsystem<UDetonationSubsystem>() };
+	if (DetonationSubsystem)
+	{
+		DetonationSubsystem->QueueDetonation(this, 0.f, Shooter, ShooterController, HitResult.Location);
+	}
+	else
+	{
+		Detonate(Shooter, ShooterController, HitResult.Location);
+	}
+}
+
+FDetonationCost AExplosive::Detonate(AActor* Shooter, AController* ShooterController, const FVector& EffectLocation)
+{
+	FDetonationCost Cost;
 	if (ImpactSound)
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, ImpactSound, GetActorLocation());
+		UShooterAudioSubsystem::PlaySoundAtLocation(GetWorld(), ImpactSound, GetActorLocation());
 	}
 	if (ExplodeParticles)
 	{
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ExplodeParticles, HitResult.Location, FRotator(0.f), true);
+		SHOOTER_INC_COUNTER(EmittersSpawned);
+		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ExplodeParticles, EffectLocation, FRotator(0.f), true);
+		Cost.NumEmitters++;
 	}
-	//TODO: Apply Exclusive Damage 
-	TArray<AActor*> OverlappingActors;
-	GetOverlappingActors(OverlappingActors, ACharacter::StaticClass());
+	Cost.NumDamageApplications = ApplyBlastDamage(Shooter, ShooterController);
 
-	for (auto Actor : OverlappingActors)
+	Destroy();
+	return Cost;
+}
+
+float AExplosive::GetChainReactionRadius() const
+{
+	return ChainReactionRadius > 0.f ? ChainReactionRadius : OverlapSphere->GetScaledSphereRadius();
+}
+
+int32 AExplosive::ApplyBlastDamage(AActor* Shooter, AController* ShooterController)
+{
+	const FVector BlastOrigin{ OverlapSphere->GetComponentLocation() };
+	const float BlastRadius{ OverlapSphere->GetScaledSphereRadius() };
+
+	TArray<ACharacter*, TInlineAllocator<16>> Characters;
+	const UCharacterGridSubsystem* CharacterGrid{ GetWorld()->GetSubsystem<UCharacterGridSubsystem>() };
+	if (CharacterGrid)
+	{
+		// The grid stores character locations, so pad the query to reach capsules whose edge is in the blast
+		CharacterGrid->QueryCharacters(BlastOrigin, BlastRadius + CharacterGrid->GetMaxCapsuleRadius(), Characters);
+	}
+	else
+	{
+		QueryOverlappingCharacters(BlastOrigin, BlastRadius, Characters);
+	}
+
+	int32 NumDamaged{ 0 };
+	for (ACharacter* Character : Characters)
 	{
-		UGameplayStatics::ApplyDamage(
-			Actor,
-			Damage,
+		// Distance to the capsule's edge rather than its center
+		const float CenterDistance{ static_cast<float>(FVector::Dist(BlastOrigin, Character->GetActorLocation())) };
+		const float Distance{ FMath::Max(CenterDistance - Character->GetCapsuleComponent()->GetScaledCapsuleRadius(), 0.f) };
+		if (Distance > BlastRadius) continue;
+		if (!HasLineOfSight(BlastOrigin, Character)) continue;
+
+		UDamagePipelineSubsystem::QueueDamage(
+			Character,
+			GetDamageAtDistance(Distance, BlastRadius),
 			ShooterController,
-			Shooter,
-			UDamageType::StaticClass());
+			Shooter);
+		NumDamaged++;
 	}
+	return NumDamaged;
+}
 
-	Destroy();
+void AExplosive::QueryOverlappingCharacters(const FVector& BlastOrigin, float BlastRadius, TArray<ACharacter*, TInlineAllocator<16>>& OutCharacters) const
+{
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ExplosiveOverlap));
+	QueryParams.AddIgnoredActor(this);
+
+	TArray<FOverlapResult> Overlaps;
+	GetWorld()->OverlapMultiByObjectType(
+		Overlaps,
+		BlastOrigin,
+		FQuat::Identity,
+		FCollisionObjectQueryParams(ECollisionChannel::ECC_Pawn),
+		FCollisionShape::MakeSphere(BlastRadius),
+		QueryParams);
+
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		ACharacter* Character{ Cast<ACharacter>(Overlap.GetActor()) };
+		if (Character)
+		{
+			OutCharacters.AddUnique(Character);
+		}
+	}
+}
+
+bool AExplosive::HasLineOfSight(const FVector& BlastOrigin, const ACharacter* Character) const
+{
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ExplosiveLineOfSight));
+	QueryParams.AddIgnoredActor(this);
+	QueryParams.AddIgnoredActor(Character);
+
+	SHOOTER_COUNT_TRACE();
+	return !GetWorld()->LineTraceTestByChannel(BlastOrigin, Character->GetActorLocation(), ECollisionChannel::ECC_Visibility, QueryParams);
+}
+
+float AExplosive::GetDamageAtDistance(float Distance, float BlastRadius) const
+{
+	if (Distance <= DamageInnerRadius || BlastRadius <= DamageInnerRadius) return Damage;
+
+	const float Alpha{ FMath::Clamp((Distance - DamageInnerRadius) / (BlastRadius - DamageInnerRadius), 0.f, 1.f) };
+	return FMath::Lerp(Damage, MinimumDamage, Alpha);
 }
 
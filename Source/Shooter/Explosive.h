@@ -7,6 +7,13 @@
 #include "BulletHitInterface.h"
 #include "Explosive.generated.h"
 
+/** Work done by one detonation, counted against UDetonationSubsystem's per-frame budget */
+struct FDetonationCost
+{
+	int32 NumEmitters{ 0 };
+	int32 NumDamageApplications{ 0 };
+};
+
 UCLASS()
 class SHOOTER_API AExplosive : public AActor, public IBulletHitInterface
 {
@@ -20,6 +27,8 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 private:
 	/** Explosion when hit by a bullet */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
@@ -33,7 +42,7 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = true))
 	class UStaticMeshComponent* ExplosiveMesh;
 	
-	/** Used to determine what actors overlap  during explosion*/
+	/** Blast radius of the explosion. Doesn't generate overlaps; characters are found through UCharacterGridSubsystem*/
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
 	class USphereComponent* OverlapSphere;
 
@@ -41,9 +50,38 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
 	float Damage;
 
+	/** Characters within this distance of the blast take full Damage*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
+	float DamageInnerRadius;
+
+	/** Damage at the edge of the blast radius; falls off linearly from Damage past DamageInnerRadius*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
+	float MinimumDamage;
+
+	/** Other explosives within this distance detonate too; 0 uses the blast radius*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = true))
+	float ChainReactionRadius;
+
+	/** Queue damage for every character within the blast radius and in line of sight of the blast. Returns the number of characters damaged*/
+	int32 ApplyBlastDamage(AActor* Shooter, AController* ShooterController);
+
+	/** Physics overlap for the characters in the blast, for worlds without a character grid*/
+	void QueryOverlappingCharacters(const FVector& BlastOrigin, float BlastRadius, TArray<class ACharacter*, TInlineAllocator<16>>& OutCharacters) const;
+
+	/** True when nothing blocks visibility between the blast and the character*/
+	bool HasLineOfSight(const FVector& BlastOrigin, const class ACharacter* Character) const;
+
+	/** Damage at Distance from the blast*/
+	float GetDamageAtDistance(float Distance, float BlastRadius) const;
+
 public:	
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 
 	virtual void BulletHit_Implementation(FHitResult  HitResult, AActor* Shooter, AController* ShooterController) override;
+
+	/** Explode now: effects at EffectLocation, blast damage, then Destroy. Called by UDetonationSubsystem*/
+	FDetonationCost Detonate(AActor* Shooter, AController* ShooterController, const FVector& EffectLocation);
+
+	float GetChainReactionRadius() const;
 };
@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FireScheduler.h"
+
+void FFireScheduler::Start(double FireTime, float InInterval)
+{
+	// A zero interval would owe an infinite number of shots
+	Interval = FMath::Max(InInterval, UE_KINDA_SMALL_NUMBER);
+	NextShotTime = FireTime + Interval;
+	bActive = true;
+}
+
+void FFireScheduler::Stop()
+{
+	bActive = false;
+}
+
+bool FFireScheduler::IsShotDue(double Now) const
+{
+	return bActive && NextShotTime <= Now;
+}
+
+int32 FFireScheduler::ConsumeShots(double Now, TArray<double, TInlineAllocator<8>>& OutShotTimes)
+{
+	if (!IsShotDue(Now)) return 0;
+
+	int32 NumShots{ 0 };
+	while (NextShotTime <= Now && NumShots < MaxShots)
+	{
+		OutShotTimes.Add(NextShotTime);
+		NextShotTime += Interval;
+		NumShots++;
+	}
+
+	if (NextShotTime <= Now)
+	{
+		// Too far behind to catch up; resume the normal rate from now
+		NextShotTime = Now + Interval;
+	}
+	return NumShots;
+}
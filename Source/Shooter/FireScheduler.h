@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Fire rate clock for one weapon, driven from the owner's tick instead of a timer.
+ * Accumulates elapsed time and hands out every shot owed since the last update, each with
+ * its exact timestamp, so the rate doesn't depend on the frame rate.
+ */
+struct FFireScheduler
+{
+public:
+	/** A shot was fired at FireTime; the next one is owed Interval seconds later */
+	void Start(double FireTime, float InInterval);
+
+	void Stop();
+
+	/** True when the next shot is owed at or before Now */
+	bool IsShotDue(double Now) const;
+
+	/**
+	 * Append the timestamps of every shot owed up to Now, oldest first, and schedule the one after.
+	 * At most MaxShots are returned; a longer backlog (after a hitch) is dropped.
+	 */
+	int32 ConsumeShots(double Now, TArray<double, TInlineAllocator<8>>& OutShotTimes);
+
+	FORCEINLINE bool IsActive() const { return bActive; }
+
+	/** Most shots handed out by a single ConsumeShots call */
+	static constexpr int32 MaxShots{ 8 };
+
+private:
+	double NextShotTime{ 0.0 };
+	float Interval{ 0.f };
+	bool bActive{ false };
+};
@@ -2,19 +2,60 @@
 
 
 #include "GruxAnimInstance.h"
+#include "GruxAnimInstanceProxy.h"
 #include "Enemy.h"
 
+UGruxAnimInstance::UGruxAnimInstance() :
+	Speed(0.f),
+	Enemy(nullptr),
+	bSkipUpdateWhenNotRendered(true)
+{
+}
+
 void UGruxAnimInstance::UpdateAnimationProperties(float DeltaTime)
 {
-	if (Enemy == nullptr)
+}
+
+void UGruxAnimInstance::NativeInitializeAnimation()
+{
+	Super::NativeInitializeAnimation();
+
+	Enemy = Cast<AEnemy>(TryGetPawnOwner());
+
+	USkeletalMeshComponent* Mesh{ GetSkelMeshComponent() };
+	if (Mesh)
 	{
-		Enemy = Cast<AEnemy>(TryGetPawnOwner());
+		Mesh->VisibilityBasedAnimTickOption = GetMoreAggressiveTickOption(Mesh->VisibilityBasedAnimTickOption, GetMinVisibilityBasedAnimTickOption());
 	}
+}
 
-	if (Enemy)
+EVisibilityBasedAnimTickOption UGruxAnimInstance::GetMinVisibilityBasedAnimTickOption() const
+{
+	return bSkipUpdateWhenNotRendered ? EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered : EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+}
+
+EVisibilityBasedAnimTickOption UGruxAnimInstance::GetMoreAggressiveTickOption(EVisibilityBasedAnimTickOption A, EVisibilityBasedAnimTickOption B)
+{
+	return GetTickOptionAggressiveness(B) > GetTickOptionAggressiveness(A) ? B : A;
+}
+
+int32 UGruxAnimInstance::GetTickOptionAggressiveness(EVisibilityBasedAnimTickOption Option)
+{
+	switch (Option)
 	{
-		FVector Velocity{ Enemy->GetVelocity() };
-		Velocity.Z = 0.F;
-		Speed = Velocity.Size();
+	case EVisibilityBasedAnimTickOption::AlwaysTickPose:
+		return 1;
+	case EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered:
+		return 2;
+	case EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered:
+		return 3;
+	case EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones:
+	default:
+		return 0;
 	}
 }
+
+FAnimInstanceProxy* UGruxAnimInstance::CreateAnimInstanceProxy()
+{
+	return new FGruxAnimInstanceProxy(this);
+}
@@ -7,17 +7,36 @@
 #include "GruxAnimInstance.generated.h"
 
 /**
- * 
+ * Anim instance for Grux enemies. Speed is computed by FGruxAnimInstanceProxy,
+ * on the animation worker threads when multi-threaded update is on.
  */
 UCLASS()
 class SHOOTER_API UGruxAnimInstance : public UAnimInstance
 {
 	GENERATED_BODY()
 public:
-	UFUNCTION(BlueprintCallable)
+	UGruxAnimInstance();
+
+	/** No-op; Speed is updated by FGruxAnimInstanceProxy every frame */
+	UFUNCTION(BlueprintCallable, meta = (DeprecatedFunction, DeprecationMessage = "Updated automatically by FGruxAnimInstanceProxy; remove this call from the event graph"))
 	void UpdateAnimationProperties(float DeltaTime);
 
+	virtual void NativeInitializeAnimation() override;
+
+	/** Least aggressive visibility based tick option the owning mesh should use */
+	EVisibilityBasedAnimTickOption GetMinVisibilityBasedAnimTickOption() const;
+
+	/** Whichever of the two options skips more of the update while the mesh isn't rendered */
+	static EVisibilityBasedAnimTickOption GetMoreAggressiveTickOption(EVisibilityBasedAnimTickOption A, EVisibilityBasedAnimTickOption B);
+
+protected:
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override;
+
 private:
+	friend struct FGruxAnimInstanceProxy;
+
+	/** How much of the update an option skips off screen, 0 for none; independent of the enum's declaration order */
+	static int32 GetTickOptionAggressiveness(EVisibilityBasedAnimTickOption Option);
 
 	/** Lateral movement speed */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Movement, meta = (AllowPrivateAccess = true));
@@ -25,4 +44,8 @@ private:
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = true));
 	class AEnemy* Enemy;
+
+	/** Only tick montages while the mesh isn't rendered, skipping the graph update entirely */
+	UPROPERTY(EditDefaultsOnly, Category = Optimization, meta = (AllowPrivateAccess = true))
+	bool bSkipUpdateWhenNotRendered;
 };
@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GruxAnimInstanceProxy.h"
+#include "GruxAnimInstance.h"
+#include "Enemy.h"
+
+FGruxAnimInstanceProxy::FGruxAnimInstanceProxy(UAnimInstance* InAnimInstance) :
+	FAnimInstanceProxy(InAnimInstance)
+{
+}
+
+void FGruxAnimInstanceProxy::Initialize(UAnimInstance* InAnimInstance)
+{
+	Super::Initialize(InAnimInstance);
+
+	GruxAnimInstance = Cast<UGruxAnimInstance>(InAnimInstance);
+}
+
+void FGruxAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds)
+{
+	Super::PreUpdate(InAnimInstance, DeltaSeconds);
+
+	bHasEnemy = false;
+	if (GruxAnimInstance == nullptr) return;
+
+	if (GruxAnimInstance->Enemy == nullptr)
+	{
+		GruxAnimInstance->Enemy = Cast<AEnemy>(GruxAnimInstance->TryGetPawnOwner());
+	}
+	if (GruxAnimInstance->Enemy)
+	{
+		bHasEnemy = true;
+		Velocity = GruxAnimInstance->Enemy->GetVelocity();
+	}
+}
+
+void FGruxAnimInstanceProxy::Update(float DeltaSeconds)
+{
+	Super::Update(DeltaSeconds);
+
+	if (GruxAnimInstance == nullptr || !bHasEnemy) return;
+
+	FVector LateralVelocity{ Velocity };
+	LateralVelocity.Z = 0.f;
+	GruxAnimInstance->Speed = LateralVelocity.Size();
+}
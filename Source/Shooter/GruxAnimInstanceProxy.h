@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "GruxAnimInstanceProxy.generated.h"
+
+class UGruxAnimInstance;
+
+/**
+ * Runs UGruxAnimInstance's update on the animation worker threads.
+ * PreUpdate copies the enemy's velocity on the game thread; Update turns it into Speed.
+ */
+USTRUCT()
+struct SHOOTER_API FGruxAnimInstanceProxy : public FAnimInstanceProxy
+{
+	GENERATED_BODY()
+
+public:
+	FGruxAnimInstanceProxy() = default;
+	explicit FGruxAnimInstanceProxy(UAnimInstance* InAnimInstance);
+
+protected:
+	virtual void Initialize(UAnimInstance* InAnimInstance) override;
+	virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override;
+	virtual void Update(float DeltaSeconds) override;
+
+private:
+	UGruxAnimInstance* GruxAnimInstance{ nullptr };
+
+	/** Enemy velocity, copied on the game thread */
+	FVector Velocity{ 0.f };
+
+	/** False until the owning enemy is found */
+	bool bHasEnemy{ false };
+};
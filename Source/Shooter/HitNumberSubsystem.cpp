@@ -0,0 +1,168 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HitNumberSubsystem.h"
+#include "HitNumberWidget.h"
+#include "Blueprint/UserWidget.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "SceneView.h"
+#include "ShooterStats.h"
+
+void UHitNumberSubsystem::Deinitialize()
+{
+	// The widgets belong to the viewport, which outlives this world
+	for (UHitNumberWidget* Widget : Widgets)
+	{
+		if (Widget)
+		{
+			Widget->RemoveFromParent();
+		}
+	}
+	for (UUserWidget* Widget : StoredWidgets)
+	{
+		if (Widget)
+		{
+			Widget->RemoveFromParent();
+		}
+	}
+	Widgets.Empty();
+	Locations.Empty();
+	ExpiryTimes.Empty();
+	StoredWidgets.Empty();
+	StoredLocations.Empty();
+	StoredExpiryTimes.Empty();
+	NextSlot = 0;
+	NumActive = 0;
+
+	Super::Deinitialize();
+}
+
+void UHitNumberSubsystem::Tick(float DeltaTime)
+{
+	SHOOTER_SCOPE_CYCLE_COUNTER(UpdateHitNumbers);
+	Super::Tick(DeltaTime);
+
+	const float Now{ GetWorld()->GetTimeSeconds() };
+	for (int32 Slot = 0; Slot < ExpiryTimes.Num(); Slot++)
+	{
+		if (ExpiryTimes[Slot] > 0.f && ExpiryTimes[Slot] <= Now)
+		{
+			ReleaseSlot(Slot);
+		}
+	}
+	for (int32 i = StoredWidgets.Num() - 1; i >= 0; i--)
+	{
+		if (StoredWidgets[i] == nullptr || StoredExpiryTimes[i] <= Now)
+		{
+			if (StoredWidgets[i])
+			{
+				StoredWidgets[i]->RemoveFromParent();
+			}
+			StoredWidgets.RemoveAtSwap(i, 1, false);
+			StoredLocations.RemoveAtSwap(i, 1, false);
+			StoredExpiryTimes.RemoveAtSwap(i, 1, false);
+		}
+	}
+	if (NumActive == 0 && StoredWidgets.Num() == 0) return;
+
+	// Build the view projection once and project every live number against it
+	APlayerController* PlayerController{ GetWorld()->GetFirstPlayerController() };
+	ULocalPlayer* LocalPlayer{ PlayerController ? PlayerController->GetLocalPlayer() : nullptr };
+	if (LocalPlayer == nullptr || LocalPlayer->ViewportClient == nullptr) return;
+
+	FSceneViewProjectionData ProjectionData;
+	if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData)) return;
+
+	const FMatrix ViewProjectionMatrix{ ProjectionData.ComputeViewProjectionMatrix() };
+	const FIntRect ViewRect{ ProjectionData.GetConstrainedViewRect() };
+	for (int32 Slot = 0; Slot < ExpiryTimes.Num(); Slot++)
+	{
+		if (ExpiryTimes[Slot] == 0.f) continue;
+
+		FVector2D ScreenPosition;
+		if (FSceneView::ProjectWorldToScreen(Locations[Slot], ViewRect, ViewProjectionMatrix, ScreenPosition))
+		{
+			Widgets[Slot]->SetPositionInViewport(ScreenPosition);
+		}
+	}
+	for (int32 i = 0; i < StoredWidgets.Num(); i++)
+	{
+		FVector2D ScreenPosition;
+		if (FSceneView::ProjectWorldToScreen(StoredLocations[i], ViewRect, ViewProjectionMatrix, ScreenPosition))
+		{
+			StoredWidgets[i]->SetPositionInViewport(ScreenPosition);
+		}
+	}
+}
+
+TStatId UHitNumberSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UHitNumberSubsystem, STATGROUP_Tickables);
+}
+
+bool UHitNumberSubsystem::IsTickable() const
+{
+	return NumActive > 0 || StoredWidgets.Num() > 0;
+}
+
+bool UHitNumberSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UHitNumberSubsystem::ShowHitNumber(TSubclassOf<UHitNumberWidget> WidgetClass, int32 Damage, const FVector& Location, bool bHeadShot, float Lifetime)
+{
+	if (Widgets.Num() == 0 && !CreateWidgets(WidgetClass)) return;
+
+	const int32 Slot{ NextSlot };
+	NextSlot = (NextSlot + 1) % Widgets.Num();
+
+	if (ExpiryTimes[Slot] == 0.f)
+	{
+		NumActive++;
+		Widgets[Slot]->SetVisibility(ESlateVisibility::HitTestInvisible);
+	}
+	Locations[Slot] = Location;
+	ExpiryTimes[Slot] = GetWorld()->GetTimeSeconds() + Lifetime;
+
+	Widgets[Slot]->SetHitNumber(Damage, bHeadShot);
+}
+
+void UHitNumberSubsystem::StoreHitNumber(UUserWidget* Widget, const FVector& Location, float Lifetime)
+{
+	if (Widget == nullptr) return;
+
+	StoredWidgets.Add(Widget);
+	StoredLocations.Add(Location);
+	StoredExpiryTimes.Add(GetWorld()->GetTimeSeconds() + Lifetime);
+}
+
+bool UHitNumberSubsystem::CreateWidgets(TSubclassOf<UHitNumberWidget> WidgetClass)
+{
+	APlayerController* PlayerController{ GetWorld()->GetFirstPlayerController() };
+	if (WidgetClass == nullptr || PlayerController == nullptr) return false;
+
+	Widgets.Reserve(MaxHitNumbers);
+	for (int32 i = 0; i < MaxHitNumbers; i++)
+	{
+		UHitNumberWidget* Widget{ CreateWidget<UHitNumberWidget>(PlayerController, WidgetClass) };
+		if (Widget == nullptr) break;
+		SHOOTER_INC_COUNTER(WidgetsCreated);
+
+		Widget->SetVisibility(ESlateVisibility::Collapsed);
+		Widget->AddToViewport();
+		Widgets.Add(Widget);
+	}
+	Locations.Init(FVector::ZeroVector, Widgets.Num());
+	ExpiryTimes.Init(0.f, Widgets.Num());
+
+	return Widgets.Num() > 0;
+}
+
+void UHitNumberSubsystem::ReleaseSlot(int32 Slot)
+{
+	ExpiryTimes[Slot] = 0.f;
+	Widgets[Slot]->SetVisibility(ESlateVisibility::Collapsed);
+	NumActive--;
+}
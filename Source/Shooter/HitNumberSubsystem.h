@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HitNumberSubsystem.generated.h"
+
+class UHitNumberWidget;
+class UUserWidget;
+
+/**
+ * Shows damage numbers from a fixed ring of reusable widgets.
+ * Hit locations and expiry times live in flat arrays alongside the ring; every live number is
+ * projected to the screen in one pass per frame and hidden once its expiry time has passed.
+ */
+UCLASS()
+class SHOOTER_API UHitNumberSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override;
+
+	/** Show a number at a world location. The ring is created from the first WidgetClass passed in;
+	 *  when every widget is in use the oldest one is reused */
+	void ShowHitNumber(TSubclassOf<UHitNumberWidget> WidgetClass, int32 Damage, const FVector& Location, bool bHeadShot, float Lifetime);
+
+	/** Keep a widget created elsewhere (e.g. by a Blueprint ShowHitNumber) over Location, and remove it from its parent after Lifetime */
+	void StoreHitNumber(UUserWidget* Widget, const FVector& Location, float Lifetime);
+
+	FORCEINLINE int32 GetNumActiveHitNumbers() const { return NumActive; }
+
+	/** Size of the widget ring */
+	static constexpr int32 MaxHitNumbers{ 64 };
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Create every widget in the ring up front, hidden */
+	bool CreateWidgets(TSubclassOf<UHitNumberWidget> WidgetClass);
+
+	/** Hide the number in this slot */
+	void ReleaseSlot(int32 Slot);
+
+	UPROPERTY()
+	TArray<UHitNumberWidget*> Widgets;
+
+	/** World location of the number in each slot */
+	TArray<FVector> Locations;
+
+	/** World time each slot expires at; 0 for free slots */
+	TArray<float> ExpiryTimes;
+
+	/** Slot the next number goes into */
+	int32 NextSlot{ 0 };
+
+	/** Widgets handed in through StoreHitNumber, with their world locations and expiry times */
+	UPROPERTY()
+	TArray<UUserWidget*> StoredWidgets;
+	TArray<FVector> StoredLocations;
+	TArray<float> StoredExpiryTimes;
+
+	int32 NumActive{ 0 };
+};
@@ -0,0 +1,21 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "HitNumberWidget.generated.h"
+
+/**
+ * Damage number shown over an enemy. Instances are owned and reused by UHitNumberSubsystem.
+ */
+UCLASS(Abstract)
+class SHOOTER_API UHitNumberWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	/** Called each time this widget is reused for a new hit; set the text and restart animations here */
+	UFUNCTION(BlueprintImplementableEvent)
+	void SetHitNumber(int32 Damage, bool bHeadShot);
+};
@@ -0,0 +1,123 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HitscanSubsystem.h"
+#include "Engine/World.h"
+#include "Async/ParallelFor.h"
+#include "ShooterStats.h"
+
+void FHitscanTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Subsystem)
+	{
+		Subsystem->ResolveShots();
+	}
+}
+
+FString FHitscanTickFunction::DiagnosticMessage()
+{
+	return TEXT("UHitscanSubsystem::ResolveShots");
+}
+
+void UHitscanSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Resolve after physics so the traces see this frame's collision
+	ResolveTickFunction.Subsystem = this;
+	ResolveTickFunction.bCanEverTick = true;
+	ResolveTickFunction.bStartWithTickEnabled = true;
+	ResolveTickFunction.TickGroup = TG_PostPhysics;
+	ResolveTickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UHitscanSubsystem::Deinitialize()
+{
+	if (ResolveTickFunction.IsTickFunctionRegistered())
+	{
+		ResolveTickFunction.UnRegisterTickFunction();
+	}
+	PendingShots.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UHitscanSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UHitscanSubsystem::QueueShot(FHitscanRequest&& Request)
+{
+	PendingShots.Add(MoveTemp(Request));
+}
+
+void UHitscanSubsystem::ResolveShots()
+{
+	if (PendingShots.Num() == 0) return;
+
+	// Swap out the queue so shots fired from the callbacks go into next frame's batch
+	Swap(PendingShots, ResolvingShots);
+	PendingShots.Reset();
+
+	const int32 NumShots{ ResolvingShots.Num() };
+	Results.Reset();
+	Results.SetNum(NumShots);
+
+	// Scene queries are read only here; physics has finished for the frame
+	const UWorld* World{ GetWorld() };
+	ParallelFor(NumShots, [this, World](int32 Index)
+	{
+		GetBeamEndLocation(World, ResolvingShots[Index], Results[Index]);
+	});
+
+	for (int32 i = 0; i < NumShots; i++)
+	{
+		ResolvingShots[i].OnResolved.ExecuteIfBound(Results[i]);
+	}
+	ResolvingShots.Reset();
+}
+
+void UHitscanSubsystem::GetBeamEndLocation(const UWorld* World, const FHitscanRequest& Request, FHitscanResult& OutResult)
+{
+	SHOOTER_SCOPE_CYCLE_COUNTER(GetBeamEndLocation);
+
+	OutResult.MuzzleTransform = Request.MuzzleTransform;
+	OutResult.Damage = Request.Damage;
+	OutResult.HeadShotDamage = Request.HeadShotDamage;
+
+	// Check for crosshair hit, unless the shooter already had it cached for this frame
+	FVector OutBeamLocation{ Request.CrosshairTraceEnd };
+	if (!Request.bCrosshairResolved)
+	{
+		FHitResult CrosshairHitResult;
+		SHOOTER_COUNT_TRACE();
+		World->LineTraceSingleByChannel(
+			CrosshairHitResult,
+			Request.CrosshairTraceStart,
+			Request.CrosshairTraceEnd,
+			ECollisionChannel::ECC_Visibility);
+		if (CrosshairHitResult.bBlockingHit)
+		{
+			//Tentative beam location - still need to trace from gun
+			OutBeamLocation = CrosshairHitResult.Location;
+		}
+	}
+
+	// Perform trace from gun barrel
+	const FVector MuzzleSocketLocation{ Request.MuzzleTransform.GetLocation() };
+	const FVector StartToEnd{ OutBeamLocation - MuzzleSocketLocation };
+	const FVector WeaponTraceEnd{ StartToEnd * 1.25f + MuzzleSocketLocation };
+	SHOOTER_COUNT_TRACE();
+	World->LineTraceSingleByChannel(
+		OutResult.BeamHitResult,
+		MuzzleSocketLocation,
+		WeaponTraceEnd,
+		ECollisionChannel::ECC_Visibility);
+
+	OutResult.bBeamHit = OutResult.BeamHitResult.bBlockingHit;
+	if (!OutResult.bBeamHit) // Object between barrel and BeamEndPoint?
+	{
+		OutResult.BeamHitResult.Location = OutBeamLocation;
+	}
+}
@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "HitscanSubsystem.generated.h"
+
+/** Result of a traced shot, handed back to the shooter in the post physics pass */
+struct FHitscanResult
+{
+	/** Hit from the barrel trace. Location is the beam end point when nothing was hit */
+	FHitResult BeamHitResult;
+
+	/** True when the trace from the barrel hit something */
+	bool bBeamHit = false;
+
+	/** Barrel socket transform the shot was fired from */
+	FTransform MuzzleTransform;
+
+	/** Damage of the weapon that fired the shot, from the request */
+	float Damage = 0.f;
+	float HeadShotDamage = 0.f;
+};
+
+DECLARE_DELEGATE_OneParam(FOnHitscanResolved, const FHitscanResult&);
+
+/** A single shot waiting for the batched trace pass */
+struct FHitscanRequest
+{
+	/** Barrel socket transform at the time of firing */
+	FTransform MuzzleTransform;
+
+	/** Crosshair ray deprojected on the game thread when the shot was fired */
+	FVector CrosshairTraceStart;
+	FVector CrosshairTraceEnd;
+
+	/** True when CrosshairTraceEnd is already this frame's crosshair hit and needs no trace */
+	bool bCrosshairResolved = false;
+
+	/** Damage of the weapon when the shot was fired; it may be dropped or swapped before the shot resolves */
+	float Damage = 0.f;
+	float HeadShotDamage = 0.f;
+
+	/** Called on the game thread once the shot has been traced */
+	FOnHitscanResolved OnResolved;
+};
+
+class UHitscanSubsystem;
+
+/** Runs the queued shots once physics has finished for the frame */
+USTRUCT()
+struct FHitscanTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UHitscanSubsystem* Subsystem = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FHitscanTickFunction> : public TStructOpsTypeTraitsBase2<FHitscanTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * Collects every shot fired during a frame and traces them together on worker threads.
+ * Results are handed back to the shooters in a single pass after physics.
+ */
+UCLASS()
+class SHOOTER_API UHitscanSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	/** Queue a shot to be traced with the rest of this frame's shots */
+	void QueueShot(FHitscanRequest&& Request);
+
+	/** Trace all queued shots in parallel, then call back each shooter on the game thread */
+	void ResolveShots();
+
+	/** Crosshair trace followed by the trace from the barrel. Safe to call from worker threads */
+	static void GetBeamEndLocation(const UWorld* World, const FHitscanRequest& Request, FHitscanResult& OutResult);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+
+	FHitscanTickFunction ResolveTickFunction;
+
+	/** Shots queued since the last resolve */
+	TArray<FHitscanRequest> PendingShots;
+
+	/** Shots being resolved this frame; kept around so the arrays don't reallocate every frame */
+	TArray<FHitscanRequest> ResolvingShots;
+	TArray<FHitscanResult> Results;
+};
@@ -10,6 +10,12 @@
 #include "Kismet/GameplayStatics.h"
 #include "Sound/SoundCue.h"
 #include "Curves/CurveVector.h"
+#include "ItemTickSubsystem.h"
+#include "ItemPulseSubsystem.h"
+#include "ShooterDataTableCache.h"
+#include "ShooterStats.h"
+#include "ShooterAudioSubsystem.h"
+#include "ItemGridSubsystem.h"
 
 // Sets default values
 AItem::AItem() :
@@ -33,12 +39,18 @@ AItem::AItem() :
 	GlowAmount(150.f),
 	FresnelExponent(3.f),
 	FresnelReflectFraction(4.f),
+	PulseStartTime(0.f),
+	bCurvePulse(false),
 	PulseCurveTime(5.f),
 	SlotIndex(0),
-	bCharacterInventoryFull(false)
+	bCharacterInventoryFull(false),
+	bRegisteredForItemTick(false),
+	bBlueprintTick(false)
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+ 	// Items are updated in a batch by UItemTickSubsystem, only while they have something to do.
+	// The actor tick is kept for Blueprints that implement Event Tick
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	ItemMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("ItemMesh"));
 	SetRootComponent(ItemMesh);
@@ -55,6 +67,9 @@ AItem::AItem() :
 
 	AreaSphere = CreateDefaultSubobject<USphereComponent>(TEXT("AreaSphere"));
 	AreaSphere->SetupAttachment(GetRootComponent());
+	// Only defines the pickup radius; characters find items through UItemGridSubsystem
+	AreaSphere->SetGenerateOverlapEvents(false);
+	AreaSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 
 }
 
@@ -73,47 +88,53 @@ void AItem::BeginPlay()
 	SetActiveStars();
 	
 
-	// Setup overlap for AreaSphere
-	AreaSphere->OnComponentBeginOverlap.AddDynamic(this, &AItem::OnSphereOverlap);
-	AreaSphere->OnComponentEndOverlap.AddDynamic(this, &AItem::OnSphereEndOverlap);
-
 	//Set Item properties based on ItemState
 	SetItemProperties(ItemState);
 
 	//Set custom depth to diabled
 	InitializeCustomDepth();
 
-	StartPulseTimer();
+	UpdatePulse();
+
+	RegisterForItemTick();
 
+	UpdateItemGridRegistration();
+
+	bBlueprintTick = GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(AItem, ReceiveTick));
+	UpdateActorTick();
 }
 
-void AItem::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep,const FHitResult& Hit)
+void AItem::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	if(OtherActor)
+	UItemGridSubsystem* ItemGrid{ GetWorld()->GetSubsystem<UItemGridSubsystem>() };
+	if (ItemGrid)
 	{
-		AShooterCharacter* ShooterCharacter = Cast<AShooterCharacter>(OtherActor);
-		if(ShooterCharacter)
-		{
-			ShooterCharacter->IncrementOvelappedItemCount(1);
-		}
+		ItemGrid->RemoveItem(this);
 	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
-void AItem::OnSphereEndOverlap(UPrimitiveComponent *OverlappedComponent, AActor *OtherActor, UPrimitiveComponent *OtherComp, int32 OtherBodyIndex)
+void AItem::UpdateItemGridRegistration()
 {
-	if(OtherActor)
+	UItemGridSubsystem* ItemGrid{ GetWorld()->GetSubsystem<UItemGridSubsystem>() };
+	if (ItemGrid == nullptr) return;
+
+	if (ItemState == EItemState::EIS_Pickup)
 	{
-		AShooterCharacter* ShooterCharacter = Cast<AShooterCharacter>(OtherActor);
-		if(ShooterCharacter)
-		{
-			ShooterCharacter->IncrementOvelappedItemCount(-1);
-			ShooterCharacter->UnHighlightInventorySlot();
-		}
+		ItemGrid->AddItem(this);
+	}
+	else
+	{
+		ItemGrid->RemoveItem(this);
 	}
 }
 
 void AItem::SetActiveStars()
 {
+	// Rebuilt from scratch when a pooled item is re-armed
+	ActiveStars.Reset();
+
 	// The 0 element isn't used
 	for (int32 i = 0; i <= 5; i++)
 	{
@@ -160,9 +181,6 @@ void AItem::SetItemProperties(EItemState State)
 			ItemMesh->SetVisibility(true);
 			ItemMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
 			ItemMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-			//Set AreaSphere properties
-			AreaSphere->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Overlap);
-			AreaSphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
 			//Set CollisionBox properties
 			CollisionBox->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
 			CollisionBox->SetCollisionResponseToChannel(
@@ -178,9 +196,6 @@ void AItem::SetItemProperties(EItemState State)
 			ItemMesh->SetVisibility(true);
 			ItemMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
 			ItemMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-			//Set AreaSphere properties
-			AreaSphere->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			AreaSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 			//Set CollisionBox properties
 			CollisionBox->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
 			CollisionBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
@@ -195,9 +210,6 @@ void AItem::SetItemProperties(EItemState State)
 			ItemMesh->SetCollisionResponseToChannel(
 				ECollisionChannel::ECC_WorldStatic,
 				ECollisionResponse::ECR_Block);
-			//Set AreaSphere properties
-			AreaSphere->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			AreaSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 			//Set CollisionBox properties
 			CollisionBox->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
 			CollisionBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
@@ -210,9 +222,6 @@ void AItem::SetItemProperties(EItemState State)
 			ItemMesh->SetVisibility(true);
 			ItemMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
 			ItemMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-			//Set AreaSphere properties
-			AreaSphere->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			AreaSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 			//Set CollisionBox properties
 			CollisionBox->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
 			CollisionBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
@@ -225,9 +234,20 @@ void AItem::SetItemProperties(EItemState State)
 			ItemMesh->SetVisibility(false);
 			ItemMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
 			ItemMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-			//Set AreaSphere properties
-			AreaSphere->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-			AreaSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+			//Set CollisionBox properties
+			CollisionBox->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
+			CollisionBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+			break;
+		case EItemState::EIS_Dormant:
+			// Parked in UItemPoolSubsystem until it is re-armed
+			bInterping = false;
+			PickupWidget->SetVisibility(false);
+			//Set mesh properties
+			ItemMesh->SetSimulatePhysics(false);
+			ItemMesh->SetEnableGravity(false);
+			ItemMesh->SetVisibility(false);
+			ItemMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
+			ItemMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 			//Set CollisionBox properties
 			CollisionBox->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
 			CollisionBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
@@ -255,11 +275,16 @@ void AItem::FinishInterping()
 	DisableCustomDepth();
 }
 
-void AItem::ItemInterp(float DeltaTime)
+bool AItem::IsItemInterpActive() const
+{
+	return bInterping && Character && ItemZCurve;
+}
+
+void AItem::ItemInterp(const FVector& InterpLocation, const FVector2D& InterpXY)
 {
-	if (!bInterping) return;
+	SHOOTER_SCOPE_CYCLE_COUNTER(ItemInterp);
 
-	if(Character && ItemZCurve)
+	if (IsItemInterpActive())
 	{
 		// Elapsed time wiince we started our ItemInterpTimer
 		const float ElapsedTime = GetWorldTimerManager().GetTimerElapsed(ItemInterpTimer);
@@ -267,30 +292,14 @@ void AItem::ItemInterp(float DeltaTime)
 		const float CurveValue = ItemZCurve->GetFloatValue(ElapsedTime);
 		// Get the items initial locaton when the curve started
 		FVector ItemLocation = ItemInterpStartLocation;
-		// Get location in front of the camera
-		const FVector CamereInterpLocation{ GetInterpLocation()};
-		
 		// Vector from Item to Camera Interp Location, X and Y are xeroed out
-		const FVector ItemToCamera{FVector(0.f, 0.f, (CamereInterpLocation-ItemLocation).Z)};
+		const FVector ItemToCamera{FVector(0.f, 0.f, (InterpLocation-ItemLocation).Z)};
 		//Scale factor to multiply wth CurveValue
 		const float DeltaZ = ItemToCamera.Size();
 
-		const FVector CurrentLocation {GetActorLocation()};
-		// Interpolated X Value
-		const float InterpXValue = FMath::FInterpTo(
-			CurrentLocation.X,
-			CamereInterpLocation.X,
-			DeltaTime,
-			30.f);
-		// Interpolated Y Value
-		const float InterpYValue = FMath::FInterpTo(
-			CurrentLocation.Y,
-			CamereInterpLocation.Y,
-			DeltaTime,
-			30.f);
 		// Set X and Y of ItemLocation to Interped values
-		ItemLocation.X = InterpXValue;
-		ItemLocation.Y = InterpYValue;
+		ItemLocation.X = InterpXY.X;
+		ItemLocation.Y = InterpXY.Y;
 
 		// Adding curve value to the Z component of the Inital Locations(Scaled by DeltaZ)
 		ItemLocation.Z +=CurveValue * DeltaZ;
@@ -335,21 +344,14 @@ void AItem::PlayPickupSound(bool bForcePlaySound)
 {
 	if (Character)
 	{
-		if (bForcePlaySound)
-		{
-			if (PickupSound)
-			{
-				UGameplayStatics::PlaySound2D(this, PickupSound);
-			}
-		}
-		else if (Character->ShouldPlayPickupSound())
-		{ 
-			Character->StartPickupSoundTimer();
-			if (PickupSound)
-			{
-				UGameplayStatics::PlaySound2D(this, PickupSound);
-			}
-		}
+		// Debounced per character, so picking up several items at once plays one sound
+		UShooterAudioSubsystem::PlayDebouncedSound2D(
+			GetWorld(),
+			PickupSound,
+			Character,
+			FName("Pickup"),
+			Character->GetPickupSoundResetTime(),
+			bForcePlaySound);
 	}
 }
 
@@ -376,62 +378,48 @@ void AItem::InitializeCustomDepth()
 
 void AItem::OnConstruction(const FTransform& Transform)
 {
+	ApplyItemData();
+}
 
-	
-
-	//Load the date in the Item Rarity Data Table
-	
-	// Path to the  Item Rarity Data Table
-	FString RarityTablePath(TEXT("/Script/Engine.DataTable'/Game/_Game/DataTable/ItemRarityDataTable.ItemRarityDataTable'"));
-	UDataTable* RarityTableObject = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, *RarityTablePath));
-	if (RarityTableObject)
+void AItem::ApplyItemData()
+{
+	// Rarity rows are loaded and resolved once, not on every construction pass
+	const FItemRarityTable* RarityRow = FShooterDataTableCache::Get().GetRarityRow(ItemRarity);
+	if (RarityRow)
 	{
-		FItemRarityTable* RarityRow = nullptr;
-		switch (ItemRarity)
+		GlowColor = RarityRow->GlowColor;
+		LightColor = RarityRow->LightColor;
+		DarkColor = RarityRow->DarkColor;
+		NumberOfStars = RarityRow->NumberOfStars;
+		IconBackground = RarityRow->IconBackground;
+		if (GetItemMesh())
 		{
-			case EItemRarity::EIR_Damaged:
-				RarityRow = RarityTableObject->FindRow<FItemRarityTable>(FName("Damaged"), TEXT(""));
-				
-
-				break;
-			case EItemRarity::EIR_Common:
-				RarityRow = RarityTableObject->FindRow<FItemRarityTable>(FName("Common"), TEXT(""));
-
-				break;
-			case EItemRarity::EIR_Uncommon:
-				RarityRow = RarityTableObject->FindRow<FItemRarityTable>(FName("Uncommon"), TEXT(""));
-
-				break;
-			case EItemRarity::EIR_Rare:
-				RarityRow = RarityTableObject->FindRow<FItemRarityTable>(FName("Rare"), TEXT(""));
-
-				break;
-			case EItemRarity::EIR_Legendary:
-				RarityRow = RarityTableObject->FindRow<FItemRarityTable>(FName("Legendary"), TEXT(""));
-
-				break;
-		}
-		if (RarityRow)
-		{
-			GlowColor = RarityRow->GlowColor;
-			LightColor = RarityRow->LightColor;
-			DarkColor = RarityRow->DarkColor;
-			NumberOfStars = RarityRow->NumberOfStars;
-			IconBackground = RarityRow->IconBackground;
-			if (GetItemMesh())
-			{
-				GetItemMesh()->SetCustomDepthStencilValue(RarityRow->CustomDepthStencil);
-			}
+			GetItemMesh()->SetCustomDepthStencilValue(RarityRow->CustomDepthStencil);
 		}
 	}
-	if (MaterialInstance)
+	UpdateDynamicMaterialInstance();
+}
+
+void AItem::UpdateDynamicMaterialInstance()
+{
+	if (MaterialInstance == nullptr) return;
+
+	// Re-armed items keep their dynamic material unless the parent changed
+	if (DynamicMaterialInstance == nullptr || DynamicMaterialInstance->Parent != MaterialInstance)
 	{
 		DynamicMaterialInstance = UMaterialInstanceDynamic::Create(MaterialInstance, this);
-		DynamicMaterialInstance->SetVectorParameterValue(TEXT("FresnelColor"), GlowColor);
-		ItemMesh->SetMaterial(MaterialIndex, DynamicMaterialInstance);
-
-		EnableGlowMaterial();
 	}
+	DynamicMaterialInstance->SetVectorParameterValue(TEXT("FresnelColor"), GlowColor);
+	ItemMesh->SetMaterial(MaterialIndex, DynamicMaterialInstance);
+
+	EnableGlowMaterial();
+}
+
+void AItem::RearmItem(EItemRarity NewRarity)
+{
+	ItemRarity = NewRarity;
+	ApplyItemData();
+	SetActiveStars();
 }
 
 void AItem::EnableGlowMaterial()
@@ -444,31 +432,72 @@ void AItem::EnableGlowMaterial()
 
 void AItem::UpdatePulse()
 {
-	float ElapsedTime{};
+	SHOOTER_SCOPE_CYCLE_COUNTER(UpdatePulse);
+
+	if (DynamicMaterialInstance == nullptr) return;
+
+	PulseStartTime = UItemPulseSubsystem::GetPulseTime(GetWorld());
+
+	// The shipped item materials don't read the pulse collection, so the curves are animated here unless
+	// both a collection is configured and this item's material exposes the pulse parameters
+	float MaterialPulseState;
+	bCurvePulse = !UItemPulseSubsystem::IsMaterialPulseEnabled(GetWorld()) ||
+		!DynamicMaterialInstance->GetScalarParameterValue(FHashedMaterialParameterInfo(TEXT("PulseState")), MaterialPulseState);
+	if (bCurvePulse)
+	{
+		UpdateCurvePulse();
+		return;
+	}
+
+	// 0 = no pulse, 1 = looping pickup pulse, 2 = one-shot interp pulse
+	float PulseState{};
+	float PulsePeriod{ PulseCurveTime };
+	switch (ItemState)
+	{
+	case EItemState::EIS_Pickup:
+		PulseState = 1.f;
+		break;
+	case  EItemState::EIS_EquipInterping:
+		PulseState = 2.f;
+		PulsePeriod = ZCurveTime;
+		break;
+	}
+
+	// The material measures its pulse from this offset against the shared PulseTime
+	DynamicMaterialInstance->SetScalarParameterValue(TEXT("PulseState"), PulseState);
+	DynamicMaterialInstance->SetScalarParameterValue(TEXT("PulsePhaseOffset"), PulseStartTime);
+	DynamicMaterialInstance->SetScalarParameterValue(TEXT("PulsePeriod"), PulsePeriod);
+	DynamicMaterialInstance->SetScalarParameterValue(TEXT("GlowAmount"), GlowAmount);
+	DynamicMaterialInstance->SetScalarParameterValue(TEXT("FresnelExponent"), FresnelExponent);
+	DynamicMaterialInstance->SetScalarParameterValue(TEXT("FresnelReflectFraction"), FresnelReflectFraction);
+}
+
+void AItem::UpdateCurvePulse()
+{
+	if (DynamicMaterialInstance == nullptr) return;
+
 	FVector CurveValue{};
 	switch (ItemState)
 	{
 	case EItemState::EIS_Pickup:
-		if (PulseCurve)
+		if (PulseCurve && PulseCurveTime > 0.f)
 		{
-			ElapsedTime = GetWorldTimerManager().GetTimerElapsed(PulseTimer);
+			// Loops every PulseCurveTime
+			const float ElapsedTime{ FMath::Fmod(UItemPulseSubsystem::GetPulseTime(GetWorld()) - PulseStartTime, PulseCurveTime) };
 			CurveValue = PulseCurve->GetVectorValue(ElapsedTime);
 		}
 		break;
 	case  EItemState::EIS_EquipInterping:
 		if (InterpPulseCurve)
 		{
-			ElapsedTime = GetWorldTimerManager().GetTimerElapsed(ItemInterpTimer);
+			const float ElapsedTime{ GetWorldTimerManager().GetTimerElapsed(ItemInterpTimer) };
 			CurveValue = InterpPulseCurve->GetVectorValue(ElapsedTime);
 		}
 		break;
 	}
-	if (DynamicMaterialInstance)
-	{
-		DynamicMaterialInstance->SetScalarParameterValue(TEXT("GlowAmount"), CurveValue.X * GlowAmount);
-		DynamicMaterialInstance->SetScalarParameterValue(TEXT("FresnelExponent"), CurveValue.Y * FresnelExponent);
-		DynamicMaterialInstance->SetScalarParameterValue(TEXT("FresnelReflectFraction"), CurveValue.Z * FresnelReflectFraction);
-	}
+	DynamicMaterialInstance->SetScalarParameterValue(TEXT("GlowAmount"), CurveValue.X * GlowAmount);
+	DynamicMaterialInstance->SetScalarParameterValue(TEXT("FresnelExponent"), CurveValue.Y * FresnelExponent);
+	DynamicMaterialInstance->SetScalarParameterValue(TEXT("FresnelReflectFraction"), CurveValue.Z * FresnelReflectFraction);
 }
 
 void AItem::DisableGlowMaterial()
@@ -483,47 +512,49 @@ void AItem::PlayEquipSound(bool bForcePlaySound)
 {
 	if (Character)
 	{
-		if (bForcePlaySound)
-		{
-			if (EquipSound)
-			{
-				UGameplayStatics::PlaySound2D(this, EquipSound);
-			}
-		}
-		else if (Character->ShouldPlayEquipSound())
-		{
-			Character->StartEquipSoundTimer();
-			if (EquipSound)
-			{
-				UGameplayStatics::PlaySound2D(this, EquipSound);
-			}
-		}
+		UShooterAudioSubsystem::PlayDebouncedSound2D(
+			GetWorld(),
+			EquipSound,
+			Character,
+			FName("Equip"),
+			Character->GetEquipSoundResetTime(),
+			bForcePlaySound);
 	}
 }
 
 
 
-// Called every frame
-void AItem::Tick(float DeltaTime)
+bool AItem::ShouldTickItem() const
 {
-	Super::Tick(DeltaTime);
-	// Handle item Interping when in the EquipInterping state
-	ItemInterp(DeltaTime);
+	// Nobody sees the pulse on an item that is off screen
+	return bInterping || (IsCurvePulsing() && WasRecentlyRendered(0.2f));
+}
 
-	// Get curve values from PulseCurve and set dynamic material parameters
-	UpdatePulse();
+bool AItem::IsCurvePulsing() const
+{
+	// A pulse the material runs needs no per-frame work; a curve pulse does
+	return bCurvePulse && ItemState == EItemState::EIS_Pickup && PulseCurve;
 }
 
-void AItem::ResetPulseTimer()
+void AItem::TickItem(float DeltaTime)
 {
-	StartPulseTimer();
+	// Interping in the EquipInterping state is batched across items by UItemTickSubsystem
+	if (bCurvePulse)
+	{
+		UpdateCurvePulse();
+	}
 }
 
-void AItem::StartPulseTimer()
+void AItem::RegisterForItemTick()
 {
-	if (ItemState == EItemState::EIS_Pickup)
+	// Off-screen pulsing items are parked by the subsystem until they are rendered
+	if (!ShouldTickItem() && !IsCurvePulsing()) return;
+
+	UWorld* World{ GetWorld() };
+	UItemTickSubsystem* ItemTickSubsystem{ World ? World->GetSubsystem<UItemTickSubsystem>() : nullptr };
+	if (ItemTickSubsystem)
 	{
-		GetWorldTimerManager().SetTimer(PulseTimer, this, &AItem::ResetPulseTimer, PulseCurveTime);
+		ItemTickSubsystem->RegisterItem(this);
 	}
 }
 
@@ -531,6 +562,17 @@ void AItem::SetItemState(EItemState State)
 {
 	ItemState = State;
 	SetItemProperties(State);
+
+	// The material only needs to hear about the pulse when the state changes
+	UpdatePulse();
+	RegisterForItemTick();
+	UpdateItemGridRegistration();
+	UpdateActorTick();
+}
+
+void AItem::UpdateActorTick()
+{
+	SetActorTickEnabled(bBlueprintTick && ItemState != EItemState::EIS_Dormant);
 }
 
 void AItem::StartItemCurve(AShooterCharacter *Char, bool bForcePlaySound)
@@ -548,14 +590,15 @@ void AItem::StartItemCurve(AShooterCharacter *Char, bool bForcePlaySound)
 	// Store initiallocation of the Item
 	ItemInterpStartLocation = GetActorLocation();
 	bInterping = true;
-	SetItemState(EItemState::EIS_EquipInterping);
-	GetWorldTimerManager().ClearTimer(PulseTimer);
 
+	// Start the timer first; the interp pulse set up by SetItemState samples its elapsed time
 	GetWorldTimerManager().SetTimer(
 		ItemInterpTimer,
 		this, 
 		&AItem::FinishInterping, 
 		ZCurveTime);
+
+	SetItemState(EItemState::EIS_EquipInterping);
 	
 	//Get initial Yaw of the camera
 	const double CameraRotationYaw{Character->GetFollowCamera()->GetComponentRotation().Yaw};
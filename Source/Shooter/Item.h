@@ -27,6 +27,7 @@ enum class EItemState : uint8
 	EIS_PickedUp UMETA(DisplayName = "PickedUp"),
 	EIS_Equipped UMETA(DisplayName = "Equipped"),
 	EIS_Falling UMETA(DisplayName = "Falling"),
+	EIS_Dormant UMETA(DisplayName = "Dormant"),
 
 
 	EIS_MAX UMETA(DisplayName = "DefaultMAX")
@@ -78,23 +79,10 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
-	/** Called when overlapping AreaSphere*/
-	UFUNCTION()
-	void OnSphereOverlap(
-		UPrimitiveComponent* OverlappedComponent, 
-		AActor* OtherActor, 
-		UPrimitiveComponent* OtherComp, 
-		int32 OtherBodyIndex, 
-		bool bFromSweep,
-		const FHitResult& Hit);
-
-	/** Called when End overlapping AreaSphere*/
-	UFUNCTION()
-	void OnSphereEndOverlap(
-		UPrimitiveComponent* OverlappedComponent, 
-		AActor* OtherActor, 
-		UPrimitiveComponent* OtherComp, 
-		int32 OtherBodyIndex);
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** In UItemGridSubsystem while in the Pickup state, out of it otherwise*/
+	void UpdateItemGridRegistration();
 
 	/** Sets the ActiveStars array of bools based on rarity*/
 	void SetActiveStars();
@@ -105,8 +93,12 @@ protected:
 	/** Called when ItemInterpTimer finish*/
 	void FinishInterping();
 
-	/** Handles item interpolation when n the EquipInterping state*/
-	void ItemInterp(float DeltaTime);
+	/** True when ItemInterp has work this frame*/
+	bool IsItemInterpActive() const;
+
+	/** Handles item interpolation when n the EquipInterping state. InterpXY is the item's X and Y
+	 *  already interpolated toward InterpLocation; UItemTickSubsystem does that for every item at once*/
+	void ItemInterp(const FVector& InterpLocation, const FVector2D& InterpXY);
 
 	/** Get interp location based on the item type*/
 	FVector GetInterpLocation();
@@ -118,19 +110,45 @@ protected:
 
 	virtual void OnConstruction(const FTransform& Transform) override;
 
+	/** Apply the rarity row and material; called on construction and when a pooled item is re-armed*/
+	virtual void ApplyItemData();
+
+	/** Create the dynamic material for MaterialInstance, keeping the current one if its parent is the same*/
+	void UpdateDynamicMaterialInstance();
+
 	void EnableGlowMaterial();
 	
+	/** Evaluate the pulse curves for the current ItemState on the CPU. Only when UItemPulseSubsystem has a
+	 *  parameter collection and the material has a PulseState parameter is the pulse state pushed to the material instead*/
 	void UpdatePulse();
-	void ResetPulseTimer();
-	void StartPulseTimer();
+
+	/** Set the glow parameters from PulseCurve or InterpPulseCurve at the current time*/
+	void UpdateCurvePulse();
+
+	/** Hand this item to the UItemTickSubsystem if it has per-frame work*/
+	void RegisterForItemTick();
+
+	/** Run the actor tick only for a Blueprint Event Tick, and never while dormant*/
+	void UpdateActorTick();
 
 public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	/** True while the item has per-frame work; checked by UItemTickSubsystem*/
+	virtual bool ShouldTickItem() const;
+
+	/** True while the Pickup pulse is animated from PulseCurve on the CPU, whether or not the item is on screen*/
+	bool IsCurvePulsing() const;
+
+	/** Per-frame update, called by UItemTickSubsystem instead of Tick*/
+	virtual void TickItem(float DeltaTime);
 
 	// Called in AShooterCharacter::GetPickupItem
 	void PlayEquipSound(bool bForcePlaySound = false);
+
+	/** Give a pooled item a new rarity without spawning a new actor*/
+	void RearmItem(EItemRarity NewRarity);
 private:
+	friend class UItemTickSubsystem;
+
 	/** Skeletal mesh for the item*/
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Item Propeties", meta =(AllowPrivateAccess = "true"))
 	USkeletalMeshComponent* ItemMesh;
@@ -231,17 +249,21 @@ private:
 
 	bool bCanChangeCustomDepth;
 
-	/** Curve to drive the dynamic material parameters*/
+	/** Curve to drive the dynamic material parameters, when the material doesn't animate the pulse*/
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Propeties", meta = (AllowPrivateAccess = "true"))
 	class UCurveVector* PulseCurve;
 
-	/** Curve to drive the dynamic material parameters*/
+	/** Curve to drive the dynamic material parameters, when the material doesn't animate the pulse*/
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Propeties", meta = (AllowPrivateAccess = "true"))
 	UCurveVector* InterpPulseCurve;
 
-	FTimerHandle PulseTimer;
+	/** Pulse time the current state's pulse started at*/
+	float PulseStartTime;
+
+	/** True while the pulse is driven from the curves on the CPU*/
+	bool bCurvePulse;
 
-	/** Time for the PulseTimer */
+	/** Length of one pulse while in the Pickup state */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Propeties", meta = (AllowPrivateAccess = "true"))
 	float PulseCurveTime;
 
@@ -293,11 +315,21 @@ private:
 	/** Background icon for the inventory*/
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Rarity, meta = (AllowPrivateAccess = "true"))
 	UTexture2D* IconBackground;
+
+	/** True while this item is in the UItemTickSubsystem active or off-screen list*/
+	bool bRegisteredForItemTick;
+
+	/** True if the Blueprint implements Event Tick*/
+	bool bBlueprintTick;
+
+	/** Speed the item's X and Y interpolate toward the interp location at*/
+	static constexpr float ItemInterpSpeed{ 30.f };
 public:
 	FORCEINLINE UWidgetComponent* GetPickupWidget() const {return PickupWidget;}
 	FORCEINLINE USphereComponent* GetAreaSphere() const {return AreaSphere;}
 	FORCEINLINE UBoxComponent* GetCollisionBox() const {return CollisionBox;}
 	FORCEINLINE EItemState GetItemState() const { return ItemState;}
+	FORCEINLINE EItemRarity GetItemRarity() const { return ItemRarity; }
 	void SetItemState(EItemState State);
 	FORCEINLINE USkeletalMeshComponent* GetItemMesh() const {return ItemMesh;}
 	FORCEINLINE USoundCue* GetPickupSound() const { return PickupSound; }
@@ -0,0 +1,164 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ItemFocusComponent.h"
+#include "ShooterCharacter.h"
+#include "Item.h"
+#include "Weapon.h"
+#include "Camera/CameraComponent.h"
+#include "Components/WidgetComponent.h"
+#include "ShooterStats.h"
+
+namespace
+{
+	/** Items lying or falling in the world; anything interping or in an inventory can't be picked up */
+	bool CanFocusItem(const AItem* Item)
+	{
+		return Item->GetItemState() == EItemState::EIS_Pickup || Item->GetItemState() == EItemState::EIS_Falling;
+	}
+}
+
+UItemFocusComponent::UItemFocusComponent() :
+	FocusedItem(nullptr),
+	RetraceAngleThreshold(0.5f),
+	RetraceDistanceThreshold(5.f),
+	LastTraceCameraLocation(FVector(0.f)),
+	LastTraceCameraRotation(FQuat::Identity),
+	bNearbyItemsChanged(false)
+{
+	// Only ticks while the character has at least one item in pickup range
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void UItemFocusComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	Character = Cast<AShooterCharacter>(GetOwner());
+}
+
+void UItemFocusComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// Focused item started interping or got equipped since the last trace. Let go of it once and
+	// look for whatever is behind it, rather than retracing every tick until focus moves
+	if (FocusedItem && !CanFocusItem(FocusedItem))
+	{
+		SetFocusedItem(nullptr);
+		bNearbyItemsChanged = true;
+	}
+
+	if (Character && ShouldTraceForItems())
+	{
+		TraceForItems();
+	}
+}
+
+void UItemFocusComponent::NotifyNearbyItemsChanged(int32 NumNearbyItems)
+{
+	bNearbyItemsChanged = true;
+	if (NumNearbyItems > 0)
+	{
+		SetComponentTickEnabled(true);
+	}
+	else
+	{
+		// no longer near any items
+		SetFocusedItem(nullptr);
+		SetComponentTickEnabled(false);
+	}
+}
+
+void UItemFocusComponent::ClearFocus()
+{
+	SetFocusedItem(nullptr);
+	bNearbyItemsChanged = true;
+}
+
+void UItemFocusComponent::RefreshFocusedItem()
+{
+	if (FocusedItem && Character)
+	{
+		FocusedItem->SetCharacterInventoryFull(Character->IsInventoryFull());
+	}
+}
+
+void UItemFocusComponent::TraceForItems()
+{
+	SHOOTER_SCOPE_CYCLE_COUNTER(TraceForItems);
+
+	const UCameraComponent* Camera{ Character->GetFollowCamera() };
+	LastTraceCameraLocation = Camera->GetComponentLocation();
+	LastTraceCameraRotation = Camera->GetComponentQuat();
+	bNearbyItemsChanged = false;
+
+	FHitResult ItemTraceResult;
+	FVector HitLocation;
+	Character->TraceUnderCrosshairs(ItemTraceResult, HitLocation);
+	if (!ItemTraceResult.bBlockingHit) return;
+
+	AItem* TraceHitItem = Cast<AItem>(ItemTraceResult.GetActor());
+	const auto TraceHitWeapon = Cast<AWeapon>(TraceHitItem);
+	if (TraceHitWeapon)
+	{
+		if (Character->GetHighlightedSlot() == -1)
+		{
+			//Not currently highlighting slot; highlight one
+			Character->HighlightInventorySlot();
+		}
+	}
+	else
+	{
+		//Is a slot being highlight?
+		if (Character->GetHighlightedSlot() != -1)
+		{
+			//Unhighlight the slot
+			Character->UnHighlightInventorySlot();
+		}
+	}
+
+	if (TraceHitItem && !CanFocusItem(TraceHitItem))
+	{
+		TraceHitItem = nullptr;
+	}
+
+	SetFocusedItem(TraceHitItem);
+}
+
+bool UItemFocusComponent::ShouldTraceForItems() const
+{
+	if (bNearbyItemsChanged) return true;
+
+	const UCameraComponent* Camera{ Character->GetFollowCamera() };
+	if (FVector::DistSquared(Camera->GetComponentLocation(), LastTraceCameraLocation) > FMath::Square(RetraceDistanceThreshold))
+	{
+		return true;
+	}
+
+	const float AngleMoved{ FMath::RadiansToDegrees(static_cast<float>(Camera->GetComponentQuat().AngularDistance(LastTraceCameraRotation))) };
+	return AngleMoved > RetraceAngleThreshold;
+}
+
+void UItemFocusComponent::SetFocusedItem(AItem* NewFocusedItem)
+{
+	if (NewFocusedItem == FocusedItem) return;
+
+	if (FocusedItem)
+	{
+		// We are hitting a different AItem from last trace, or null
+		FocusedItem->GetPickupWidget()->SetVisibility(false);
+		FocusedItem->DisableCustomDepth();
+	}
+
+	FocusedItem = NewFocusedItem;
+
+	if (FocusedItem && FocusedItem->GetPickupWidget())
+	{
+		//Show Item's pickup widget
+		FocusedItem->GetPickupWidget()->SetVisibility(true);
+		FocusedItem->EnableCustomDepth();
+		FocusedItem->SetCharacterInventoryFull(Character && Character->IsInventoryFull());
+	}
+}
@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "ItemFocusComponent.generated.h"
+
+/**
+ * Tracks which AItem the character is looking at.
+ * Only traces when the camera has moved past a threshold or the nearby items changed,
+ * and only touches the items when the focused item actually changes.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class SHOOTER_API UItemFocusComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UItemFocusComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** Called by the character whenever the pickup items in range change */
+	void NotifyNearbyItemsChanged(int32 NumNearbyItems);
+
+	/** Drop the focused item (e.g. when it gets picked up) and retrace next tick */
+	void ClearFocus();
+
+	/** Push the character's inventory state to the focused item again */
+	void RefreshFocusedItem();
+
+	FORCEINLINE class AItem* GetFocusedItem() const { return FocusedItem; }
+
+protected:
+	virtual void BeginPlay() override;
+
+	/** Line trace under the crosshairs and update the focused item */
+	void TraceForItems();
+
+	/** True if the camera moved enough, or the nearby items changed, since the last trace */
+	bool ShouldTraceForItems() const;
+
+	/** Hide the old item's widget and show the new one's */
+	void SetFocusedItem(AItem* NewFocusedItem);
+
+private:
+	UPROPERTY()
+	class AShooterCharacter* Character;
+
+	/** The item currently hit by TraceForItems() (could be null)*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Items, meta = (AllowPrivateAccess = true))
+	AItem* FocusedItem;
+
+	/** Camera rotation, in degrees, needed before we trace again*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Items, meta = (AllowPrivateAccess = true))
+	float RetraceAngleThreshold;
+
+	/** Camera movement, in cm, needed before we trace again*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Items, meta = (AllowPrivateAccess = true))
+	float RetraceDistanceThreshold;
+
+	/** Camera transform at the last trace*/
+	FVector LastTraceCameraLocation;
+	FQuat LastTraceCameraRotation;
+
+	/** True when the nearby items changed since the last trace*/
+	bool bNearbyItemsChanged;
+};
@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ItemGridSubsystem.h"
+#include "Item.h"
+#include "Components/SphereComponent.h"
+
+bool UItemGridSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UItemGridSubsystem::AddItem(AItem* Item)
+{
+	if (Item == nullptr) return;
+
+	const USphereComponent* AreaSphere{ Item->GetAreaSphere() };
+	MaxPickupRadius = FMath::Max(MaxPickupRadius, AreaSphere->GetScaledSphereRadius());
+
+	if (!Grid.Contains(Item))
+	{
+		Items.Add(Item);
+	}
+	Grid.Add(Item, AreaSphere->GetComponentLocation());
+}
+
+void UItemGridSubsystem::RemoveItem(AItem* Item)
+{
+	if (!Grid.Contains(Item)) return;
+
+	Items.RemoveSingleSwap(Item, false);
+	Grid.Remove(Item);
+}
+
+void UItemGridSubsystem::GatherItemsInPickupRange(const FVector& SegmentStart, const FVector& SegmentEnd, float Radius, TArray<AItem*>& OutItems) const
+{
+	// Sphere around the whole capsule, grown by the largest pickup radius
+	const FVector Center{ (SegmentStart + SegmentEnd) * 0.5 };
+	const float QueryRadius{ static_cast<float>(FVector::Dist(SegmentStart, SegmentEnd) * 0.5) + Radius + MaxPickupRadius };
+
+	TArray<AItem*, TInlineAllocator<32>> Candidates;
+	Grid.QuerySphere(Center, QueryRadius, Candidates);
+
+	for (AItem* Item : Candidates)
+	{
+		if (!IsValid(Item)) continue;
+
+		const USphereComponent* AreaSphere{ Item->GetAreaSphere() };
+		const float Reach{ AreaSphere->GetScaledSphereRadius() + Radius };
+		if (FMath::PointDistToSegmentSquared(AreaSphere->GetComponentLocation(), SegmentStart, SegmentEnd) <= FMath::Square(Reach))
+		{
+			OutItems.Add(Item);
+		}
+	}
+}
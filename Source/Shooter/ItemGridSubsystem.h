@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SpatialHashGrid.h"
+#include "ItemGridSubsystem.generated.h"
+
+class AItem;
+
+/**
+ * Spatial hash of every item lying in the world in the Pickup state.
+ * Replaces the overlap events of each item's AreaSphere: the sphere only defines the pickup
+ * radius and characters ask the grid which items are in range. Pickup items don't move,
+ * so an item's grid location is only set when it enters the Pickup state.
+ */
+UCLASS()
+class SHOOTER_API UItemGridSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Add the item at its current location, or move it there if it is already in the grid */
+	void AddItem(AItem* Item);
+	void RemoveItem(AItem* Item);
+
+	/** Append every item whose pickup sphere touches the capsule from SegmentStart to SegmentEnd */
+	void GatherItemsInPickupRange(const FVector& SegmentStart, const FVector& SegmentEnd, float Radius, TArray<AItem*>& OutItems) const;
+
+	FORCEINLINE int32 GetNumItems() const { return Grid.Num(); }
+
+	/** Grid cell size, in cm */
+	static constexpr float CellSize{ 500.f };
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	UPROPERTY()
+	TArray<AItem*> Items;
+
+	TSpatialHashGrid<AItem*> Grid{ CellSize };
+
+	/** Largest pickup radius of any item added so far; widens grid queries enough to find it */
+	float MaxPickupRadius{ 0.f };
+};
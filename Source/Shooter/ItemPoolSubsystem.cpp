@@ -0,0 +1,83 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ItemPoolSubsystem.h"
+#include "Item.h"
+#include "Weapon.h"
+
+AItem* UItemPoolSubsystem::AcquireItem(TSubclassOf<AItem> ItemClass, const FTransform& Transform, EItemRarity Rarity)
+{
+	if (ItemClass == nullptr) return nullptr;
+
+	AItem* Item{ PopDormantItem(ItemClass, Transform) };
+	if (Item == nullptr)
+	{
+		Item = GetWorld()->SpawnActor<AItem>(ItemClass, Transform);
+		// A fresh item already ran its construction script with the class defaults
+		if (Item == nullptr || Item->GetItemRarity() == Rarity) return Item;
+	}
+
+	Item->RearmItem(Rarity);
+	Item->SetItemState(EItemState::EIS_Pickup);
+	return Item;
+}
+
+AWeapon* UItemPoolSubsystem::AcquireWeapon(TSubclassOf<AWeapon> WeaponClass, const FTransform& Transform, EItemRarity Rarity, EWeaponType WeaponType)
+{
+	if (WeaponClass == nullptr) return nullptr;
+
+	AWeapon* Weapon{ Cast<AWeapon>(PopDormantItem(WeaponClass, Transform)) };
+	if (Weapon == nullptr)
+	{
+		Weapon = GetWorld()->SpawnActor<AWeapon>(WeaponClass, Transform);
+		if (Weapon == nullptr) return nullptr;
+		if (Weapon->GetItemRarity() == Rarity && Weapon->GetWeaponType() == WeaponType) return Weapon;
+	}
+
+	Weapon->RearmWeapon(Rarity, WeaponType);
+	Weapon->SetItemState(EItemState::EIS_Pickup);
+	return Weapon;
+}
+
+void UItemPoolSubsystem::ReleaseItem(AItem* Item)
+{
+	if (!IsValid(Item) || Item->GetItemState() == EItemState::EIS_Dormant) return;
+
+	if (DormantItems.Num() >= MaxDormantItems)
+	{
+		Item->Destroy();
+		return;
+	}
+
+	// Interp, throw and slide timers would wake the item back up
+	Item->GetWorldTimerManager().ClearAllTimersForObject(Item);
+	Item->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	Item->SetOwner(nullptr);
+	Item->SetItemState(EItemState::EIS_Dormant);
+	DormantItems.Add(Item);
+}
+
+AItem* UItemPoolSubsystem::PopDormantItem(UClass* ItemClass, const FTransform& Transform)
+{
+	for (int32 i = DormantItems.Num() - 1; i >= 0; i--)
+	{
+		AItem* Item{ DormantItems[i] };
+		if (!IsValid(Item))
+		{
+			DormantItems.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+		if (Item->GetClass() == ItemClass)
+		{
+			DormantItems.RemoveAtSwap(i, 1, false);
+			Item->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+			return Item;
+		}
+	}
+	return nullptr;
+}
+
+bool UItemPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ItemPoolSubsystem.generated.h"
+
+class AItem;
+class AWeapon;
+enum class EItemRarity : uint8;
+enum class EWeaponType : uint8;
+
+/**
+ * Pool of dormant AItem actors.
+ * Released items are parked in the Dormant item state instead of being destroyed,
+ * and re-armed with a new rarity (and weapon type) the next time an item of their class is needed.
+ */
+UCLASS()
+class SHOOTER_API UItemPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Reuse a dormant item of this class, or spawn one. The item is returned in the Pickup state */
+	AItem* AcquireItem(TSubclassOf<AItem> ItemClass, const FTransform& Transform, EItemRarity Rarity);
+
+	/** Reuse a dormant weapon of this class, or spawn one. The weapon is returned in the Pickup state */
+	AWeapon* AcquireWeapon(TSubclassOf<AWeapon> WeaponClass, const FTransform& Transform, EItemRarity Rarity, EWeaponType WeaponType);
+
+	/** Park the item until it is acquired again. Destroys it if the pool is full */
+	void ReleaseItem(AItem* Item);
+
+	FORCEINLINE int32 GetNumDormantItems() const { return DormantItems.Num(); }
+
+	/** Items beyond this are destroyed on release */
+	static constexpr int32 MaxDormantItems{ 128 };
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Take a dormant item of exactly this class out of the pool and move it to Transform */
+	AItem* PopDormantItem(UClass* ItemClass, const FTransform& Transform);
+
+	UPROPERTY()
+	TArray<AItem*> DormantItems;
+};
@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ItemPulseSubsystem.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
+
+const FName UItemPulseSubsystem::PulseTimeParameterName{ TEXT("PulseTime") };
+
+void UItemPulseSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	UMaterialParameterCollection* Collection{ PulseParameterCollection.LoadSynchronous() };
+	if (Collection)
+	{
+		PulseParameterCollectionInstance = InWorld.GetParameterCollectionInstance(Collection);
+	}
+}
+
+void UItemPulseSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	PulseParameterCollectionInstance->SetScalarParameterValue(PulseTimeParameterName, GetPulseTime(GetWorld()));
+}
+
+TStatId UItemPulseSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UItemPulseSubsystem, STATGROUP_Tickables);
+}
+
+bool UItemPulseSubsystem::IsTickable() const
+{
+	return PulseParameterCollectionInstance != nullptr;
+}
+
+float UItemPulseSubsystem::GetPulseTime(const UWorld* World)
+{
+	return World ? World->GetTimeSeconds() : 0.f;
+}
+
+bool UItemPulseSubsystem::IsMaterialPulseEnabled(const UWorld* World)
+{
+	const UItemPulseSubsystem* PulseSubsystem{ World ? World->GetSubsystem<UItemPulseSubsystem>() : nullptr };
+	return PulseSubsystem && PulseSubsystem->PulseParameterCollectionInstance;
+}
+
+bool UItemPulseSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ItemPulseSubsystem.generated.h"
+
+class UMaterialParameterCollection;
+class UMaterialParameterCollectionInstance;
+
+/**
+ * Optional material-driven item pulse. With a collection configured, publishes the shared item pulse
+ * time to it once per frame, and items whose material reads PulseTime and PulsePhaseOffset only touch
+ * the material when their state changes. No collection or materials for this ship with the project,
+ * so by default the subsystem stays idle and items evaluate their pulse curves on the CPU.
+ */
+UCLASS(Config = Game)
+class SHOOTER_API UItemPulseSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override;
+
+	/** Time the item materials pulse against; items store it as their phase offset on state change */
+	static float GetPulseTime(const UWorld* World);
+
+	/** True when the world publishes PulseTime, so item materials animate the pulse themselves */
+	static bool IsMaterialPulseEnabled(const UWorld* World);
+
+	/** Name of the scalar parameter in PulseParameterCollection */
+	static const FName PulseTimeParameterName;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Collection holding PulseTime, read by the item materials. Leave unset while the item
+	 *  materials don't read it; items then evaluate their pulse curves on the CPU */
+	UPROPERTY(Config)
+	TSoftObjectPtr<UMaterialParameterCollection> PulseParameterCollection;
+
+	/** This world's instance of PulseParameterCollection */
+	UPROPERTY()
+	UMaterialParameterCollectionInstance* PulseParameterCollectionInstance;
+};
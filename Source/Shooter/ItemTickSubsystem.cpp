@@ -0,0 +1,125 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ItemTickSubsystem.h"
+#include "Item.h"
+#include "ShooterInterp.h"
+
+void UItemTickSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	UpdateOffscreenItems();
+
+	// Walk backwards so idle items can be swapped out while we iterate
+	for (int32 i = ActiveItems.Num() - 1; i >= 0; i--)
+	{
+		AItem* Item{ ActiveItems[i] };
+		if (!IsValid(Item) || !Item->ShouldTickItem())
+		{
+			if (IsValid(Item) && Item->IsCurvePulsing())
+			{
+				// Still pulsing, just off screen
+				OffscreenItems.Add(Item);
+			}
+			else if (Item)
+			{
+				Item->bRegisteredForItemTick = false;
+			}
+			ActiveItems.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+
+		if (Item->IsItemInterpActive())
+		{
+			const FVector ItemLocation{ Item->GetActorLocation() };
+			const FVector InterpLocation{ Item->GetInterpLocation() };
+			InterpingItems.Add(Item);
+			InterpLocations.Add(InterpLocation);
+			InterpOffsets.Add(0.f);
+			InterpOffsets.Add(0.f);
+			InterpTargetOffsets.Add(static_cast<float>(InterpLocation.X - ItemLocation.X));
+			InterpTargetOffsets.Add(static_cast<float>(InterpLocation.Y - ItemLocation.Y));
+		}
+		Item->TickItem(DeltaTime);
+	}
+
+	InterpItems(DeltaTime);
+}
+
+void UItemTickSubsystem::UpdateOffscreenItems()
+{
+	const double Now{ GetWorld()->GetTimeSeconds() };
+	if (Now < NextOffscreenCheckTime) return;
+	NextOffscreenCheckTime = Now + OffscreenCheckInterval;
+
+	for (int32 i = OffscreenItems.Num() - 1; i >= 0; i--)
+	{
+		AItem* Item{ OffscreenItems[i] };
+		if (IsValid(Item) && Item->ShouldTickItem())
+		{
+			ActiveItems.Add(Item);
+		}
+		else if (IsValid(Item) && Item->IsCurvePulsing())
+		{
+			continue;
+		}
+		else if (Item)
+		{
+			Item->bRegisteredForItemTick = false;
+		}
+		OffscreenItems.RemoveAtSwap(i, 1, false);
+	}
+}
+
+void UItemTickSubsystem::InterpItems(float DeltaTime)
+{
+	ShooterInterp::InterpToBatch(InterpOffsets, InterpTargetOffsets, DeltaTime, AItem::ItemInterpSpeed);
+
+	for (int32 i = 0; i < InterpingItems.Num(); i++)
+	{
+		AItem* Item{ InterpingItems[i] };
+		if (!IsValid(Item)) continue;
+
+		const FVector ItemLocation{ Item->GetActorLocation() };
+		const FVector2D InterpXY{ ItemLocation.X + InterpOffsets[2 * i], ItemLocation.Y + InterpOffsets[2 * i + 1] };
+		Item->ItemInterp(InterpLocations[i], InterpXY);
+	}
+
+	InterpingItems.Reset();
+	InterpLocations.Reset();
+	InterpOffsets.Reset();
+	InterpTargetOffsets.Reset();
+}
+
+TStatId UItemTickSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UItemTickSubsystem, STATGROUP_Tickables);
+}
+
+bool UItemTickSubsystem::IsTickable() const
+{
+	return ActiveItems.Num() > 0 || OffscreenItems.Num() > 0;
+}
+
+bool UItemTickSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UItemTickSubsystem::RegisterItem(AItem* Item)
+{
+	if (Item == nullptr) return;
+	if (Item->bRegisteredForItemTick)
+	{
+		// Has work again while parked off screen, e.g. started interping; don't wait for the next check
+		if (Item->ShouldTickItem() && OffscreenItems.RemoveSingleSwap(Item, false) > 0)
+		{
+			ActiveItems.Add(Item);
+		}
+		return;
+	}
+
+	Item->bRegisteredForItemTick = true;
+	ActiveItems.Add(Item);
+}
@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ItemTickSubsystem.generated.h"
+
+class AItem;
+
+/**
+ * Updates every AItem that has per-frame work in one batched loop.
+ * Items don't tick themselves; they register here when they start interping, falling
+ * or pulsing and drop out of the active list as soon as AItem::ShouldTickItem() is false.
+ * Pulsing items that go off screen are parked in a separate list, checked a few times a second,
+ * and return to the active list once they are rendered again.
+ * The X/Y interpolation of all interping items runs as one SIMD batch.
+ */
+UCLASS()
+class SHOOTER_API UItemTickSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override;
+
+	/** Add an item to the active list if it isn't there already, or bring it back from the off-screen list */
+	void RegisterItem(AItem* Item);
+
+	FORCEINLINE int32 GetNumActiveItems() const { return ActiveItems.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Items that had per-frame work as of the last update */
+	UPROPERTY()
+	TArray<AItem*> ActiveItems;
+
+	/** Curve-pulsing items that weren't rendered recently; no per-frame work until they are */
+	UPROPERTY()
+	TArray<AItem*> OffscreenItems;
+
+	/** Move off-screen items that are rendered again back to the active list */
+	void UpdateOffscreenItems();
+
+	double NextOffscreenCheckTime{ 0.0 };
+
+	/** Seconds between visibility checks of the off-screen items */
+	static constexpr double OffscreenCheckInterval{ 0.2 };
+
+	/** Interp the X/Y of every item gathered this frame and move the items */
+	void InterpItems(float DeltaTime);
+
+	/** Scratch for InterpItems, kept to avoid reallocating every frame. Offsets are from each
+	 *  item's current X/Y so the float lanes don't lose precision far from the origin */
+	TArray<AItem*> InterpingItems;
+	TArray<FVector> InterpLocations;
+	TArray<float> InterpOffsets;
+	TArray<float> InterpTargetOffsets;
+};
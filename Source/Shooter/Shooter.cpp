@@ -2,5 +2,16 @@
 
 #include "Shooter.h"
 #include "Modules/ModuleManager.h"
+#include "ShooterDataTableCache.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, Shooter, "Shooter" );
+class FShooterGameModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void ShutdownModule() override
+	{
+		// Release the cached tables while the UObject system is still up
+		FShooterDataTableCache::Shutdown();
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FShooterGameModule, Shooter, "Shooter" );
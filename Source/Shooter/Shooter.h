@@ -7,3 +7,5 @@
 #define EPS_Stone EPhysicalSurface::SurfaceType1
 #define EPS_Grass EPhysicalSurface::SurfaceType2
 #define EPS_Water EPhysicalSurface::SurfaceType3
+
+DECLARE_STATS_GROUP(TEXT("Shooter"), STATGROUP_Shooter, STATCAT_Advanced);
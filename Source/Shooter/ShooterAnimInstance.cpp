@@ -2,10 +2,8 @@
 
 
 #include "ShooterAnimInstance.h"
+#include "ShooterAnimInstanceProxy.h"
 #include "ShooterCharacter.h"
-#include "GameFramework/CharacterMovementComponent.h"
-#include "Kismet/KismetMathLibrary.h"
-#include "Weapon.h"
 
 UShooterAnimInstance::UShooterAnimInstance() :
     Speed(0.f),
@@ -14,10 +12,6 @@ UShooterAnimInstance::UShooterAnimInstance() :
     MovementOffsetYaw(0.f),
     LastMovementOffsetYaw(0.f),
     bAiming(false),
-    CharacterRotation(FRotator(0.f)),
-    CharacterRotationLastFrame(FRotator(0.f)),
-    TIPCharacterYaw(0.f),
-    TIPCharacterYawLastFrame(0.f),
     YawDelta(0.f),
     RootYawOffset(0.f),
     Pitch(0.f),
@@ -33,72 +27,6 @@ UShooterAnimInstance::UShooterAnimInstance() :
 
 void UShooterAnimInstance::UpdateAnimationProperties(float DeltaTime)
 {
-    if (ShooterCharacter == nullptr)
-    {
-        ShooterCharacter = Cast<AShooterCharacter>(TryGetPawnOwner());
-    }
-    if(ShooterCharacter)
-    {
-        bCrouching = ShooterCharacter->GetCrouching();
-        bReloading = ShooterCharacter->GetCombatState() == ECombatState::ECS_Reloading;
-        bEquipping = ShooterCharacter->GetCombatState() == ECombatState::ECS_Equipping;
-        bShouldUseFABRIK = ShooterCharacter->GetCombatState() == ECombatState::ECS_Unoccupied || ShooterCharacter->GetCombatState() == ECombatState::ECS_FireTimerInProgress;
-
-        //Get the lateral speed of the character from Velocity
-        FVector Velocity{ShooterCharacter->GetVelocity()};
-        Velocity.Z = 0;
-        Speed = Velocity.Size();
-
-        // Is the character in the air ? 
-        bIsInAir = ShooterCharacter->GetCharacterMovement()->IsFalling();
-
-        // Is the character accelerating ?
-        if (ShooterCharacter->GetCharacterMovement()->GetCurrentAcceleration().Size() > 0.f)
-            bIsAccelerating = true;
-        else
-            bIsAccelerating = false;
-
-
-        FRotator AimRotation = ShooterCharacter->GetBaseAimRotation();
-        FRotator MovementRotation = 
-            UKismetMathLibrary::MakeRotFromX(
-                ShooterCharacter->GetVelocity());
-
-        MovementOffsetYaw = UKismetMathLibrary::NormalizedDeltaRotator(
-            MovementRotation,
-            AimRotation).Yaw;
-        
-        if (ShooterCharacter->GetVelocity().Size() > 0.f)
-        {
-            LastMovementOffsetYaw = MovementOffsetYaw;
-        }
-        bAiming = ShooterCharacter->GetAiming();
-
-        if (bReloading)
-        {
-            OffsetState = EOffsetState::EOS_Reloading;
-        }
-        else if (bIsInAir)
-        {
-            OffsetState = EOffsetState::EOS_InAir;
-        }
-        else if (ShooterCharacter->GetAiming())
-        {
-            OffsetState = EOffsetState::EOS_Aiming;
-        }
-        else
-        {
-            OffsetState = EOffsetState::EOS_Hip;
-        }
-        //Check if ShooterCharacter has avalid EquippedWeapon
-        if (ShooterCharacter->GetEquippedWeapon())
-        {
-            EquippedWeaponType = ShooterCharacter->GetEquippedWeapon()->GetWeaponType();
-        }
-    }
-
-    TurnInPlace();
-    Lean(DeltaTime);
 }
 
 void UShooterAnimInstance::NativeInitializeAnimation()
@@ -106,105 +34,7 @@ void UShooterAnimInstance::NativeInitializeAnimation()
     ShooterCharacter = Cast<AShooterCharacter>(TryGetPawnOwner());
 }
 
-void UShooterAnimInstance::TurnInPlace()
+FAnimInstanceProxy* UShooterAnimInstance::CreateAnimInstanceProxy()
 {
-    if (ShooterCharacter == nullptr) return;
-
-    Pitch = ShooterCharacter->GetBaseAimRotation().Pitch;
-
-    if (Speed > 0 || bIsInAir)
-    {
-        // Don't want  to turn in place; Character is moving
-        RootYawOffset = 0;
-        TIPCharacterYaw = ShooterCharacter->GetActorRotation().Yaw;
-        TIPCharacterYawLastFrame = TIPCharacterYaw;
-        RotationCurveLastFrame = 0;
-        RotationCurve = 0;
-    }
-    else
-    {
-        TIPCharacterYawLastFrame = TIPCharacterYaw;
-        TIPCharacterYaw = ShooterCharacter->GetActorRotation().Yaw;
-        const float TIPYawDelta{ TIPCharacterYaw  - TIPCharacterYawLastFrame };
-
-        // RootYawOffset updated and clamped  [-180, 180]
-        RootYawOffset = UKismetMathLibrary::NormalizeAxis(RootYawOffset - TIPYawDelta);
-
-        // 1.0 if turning, 0.0 if not
-        const float Turning{ GetCurveValue(TEXT("Turning")) };
-        if (Turning > 0)
-        {
-            bTurningInPlace = true;
-
-            RotationCurveLastFrame = RotationCurve;
-            RotationCurve = GetCurveValue(TEXT("Rotation"));
-            const float DeltaRotation{ RotationCurve - RotationCurveLastFrame };
-
-            // if RootYawOffset is posetive we are turning left, if negative we are turning right
-            RootYawOffset > 0 ? RootYawOffset -= DeltaRotation : RootYawOffset += DeltaRotation;
-
-            const float ABSRootYawOffset{ FMath::Abs(RootYawOffset) };
-            if (ABSRootYawOffset > 90.f)
-            {
-                const float YawExcess{ ABSRootYawOffset - 90.f };
-                RootYawOffset > 0 ? RootYawOffset -= YawExcess : RootYawOffset += YawExcess;
-            }
-        }
-        else
-        {
-            bTurningInPlace = false;
-        }
-    }
-    // Set the recoil weight
-    if (bTurningInPlace)
-    {
-        if (bReloading || bEquipping)
-        {
-            RecoilWeight = 1.f;
-        }
-        if (bReloading)
-        {
-            RecoilWeight = 0.f;
-        }
-    }
-    else // not turning in place
-    {
-        if (bCrouching)
-        {
-            if (bReloading || bEquipping)
-            {
-                RecoilWeight = 1.f;
-            }
-            else
-            {
-                RecoilWeight = 0.1f;
-            }
-        }
-        else
-        {
-            if (bAiming || bReloading || bEquipping)
-            {
-                RecoilWeight = 1.f;
-            }
-            else
-            {
-                RecoilWeight = 0.5f;
-            }
-        }
-    }
-}
-
-void UShooterAnimInstance::Lean(float DeltaTime)
-{
-    if (ShooterCharacter == nullptr) return;
-    CharacterRotationLastFrame = CharacterRotation;
-    CharacterRotation = ShooterCharacter->GetActorRotation();
-
-    const FRotator Delta{ UKismetMathLibrary::NormalizedDeltaRotator(CharacterRotation, CharacterRotationLastFrame) };
-
-    const float Target{ float(Delta.Yaw) / DeltaTime };
-    const float Interp{ FMath::FInterpTo(YawDelta, Target, DeltaTime, 6.f) };
-    YawDelta = FMath::Clamp(Interp, -90.f, 90.f);
-    
+    return new FShooterAnimInstanceProxy(this);
 }
-
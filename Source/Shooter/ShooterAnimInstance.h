@@ -20,7 +20,8 @@ enum class EOffsetState : uint8
 
 
 /**
- * 
+ * Anim instance for the player character. The properties below are computed by
+ * FShooterAnimInstanceProxy, on the animation worker threads when multi-threaded update is on.
  */
 UCLASS()
 class SHOOTER_API UShooterAnimInstance : public UAnimInstance
@@ -30,19 +31,18 @@ class SHOOTER_API UShooterAnimInstance : public UAnimInstance
 public:
 	UShooterAnimInstance();
 
-	UFUNCTION(BlueprintCallable)
+	/** No-op; the properties are updated by FShooterAnimInstanceProxy every frame */
+	UFUNCTION(BlueprintCallable, meta = (DeprecatedFunction, DeprecationMessage = "Updated automatically by FShooterAnimInstanceProxy; remove this call from the event graph"))
 	void UpdateAnimationProperties(float DeltaTime);
 
 	virtual void NativeInitializeAnimation() override;
 
 protected:
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override;
 
-	/** Handle turning in place variables*/
-	void TurnInPlace();
-
-	/** Handle calculations for leaning while running */
-	void Lean(float DeltaTime);
 private:
+	friend struct FShooterAnimInstanceProxy;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Movement, meta = (AllowPrivateAccess = "true"))
 	class AShooterCharacter* ShooterCharacter;
 
@@ -70,21 +70,10 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Movement, meta = (AllowPrivateAccess = "true"))
 	bool bAiming;
 
-	/** Yaw of the Character this frame; Only updatiing standing still and not in air*/
-	float TIPCharacterYaw;
-
-	/** Yaw of the Character the previous frame */
-	float TIPCharacterYawLastFrame;
-
 	/**  */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Turn In Place", meta = (AllowPrivateAccess = "true"))
 	float RootYawOffset;
 
-	/** Rotation curve value this frame */
-	float RotationCurve;
-	/** Rotation curve value last frame */
-	float RotationCurveLastFrame;
-
 	/** The Pitch of the aim rotation, used for Aim Offset */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Turn In Place", meta = (AllowPrivateAccess = "true"))
 	float Pitch;
@@ -97,12 +86,6 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Turn In Place", meta = (AllowPrivateAccess = "true"))
 	EOffsetState OffsetState;
 
-	/** Character Yaw this frame */
-	FRotator CharacterRotation;
-
-	/** Character Yaw last frame */
-	FRotator CharacterRotationLastFrame;
-
 	/** Yaw delta used for leaning n the running blendspace */
 	UPROPERTY(VisibleAnywhere,BlueprintReadWrite, Category = Lean, meta = (AllowPrivateAccess = "true"))
 	float YawDelta;
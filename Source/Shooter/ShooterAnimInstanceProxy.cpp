@@ -0,0 +1,209 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ShooterAnimInstanceProxy.h"
+#include "ShooterAnimInstance.h"
+#include "ShooterCharacter.h"
+#include "Weapon.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "ShooterStats.h"
+
+FShooterAnimInstanceProxy::FShooterAnimInstanceProxy(UAnimInstance* InAnimInstance) :
+	FAnimInstanceProxy(InAnimInstance)
+{
+}
+
+void FShooterAnimInstanceProxy::Initialize(UAnimInstance* InAnimInstance)
+{
+	Super::Initialize(InAnimInstance);
+
+	ShooterAnimInstance = Cast<UShooterAnimInstance>(InAnimInstance);
+}
+
+void FShooterAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds)
+{
+	Super::PreUpdate(InAnimInstance, DeltaSeconds);
+
+	Snapshot = FShooterAnimSnapshot();
+	if (ShooterAnimInstance == nullptr) return;
+
+	if (ShooterAnimInstance->ShooterCharacter == nullptr)
+	{
+		ShooterAnimInstance->ShooterCharacter = Cast<AShooterCharacter>(ShooterAnimInstance->TryGetPawnOwner());
+	}
+	const AShooterCharacter* ShooterCharacter{ ShooterAnimInstance->ShooterCharacter };
+	if (ShooterCharacter == nullptr) return;
+
+	const ECombatState CombatState{ ShooterCharacter->GetCombatState() };
+	const UCharacterMovementComponent* Movement{ ShooterCharacter->GetCharacterMovement() };
+
+	Snapshot.bHasCharacter = true;
+	Snapshot.Velocity = ShooterCharacter->GetVelocity();
+	Snapshot.AimRotation = ShooterCharacter->GetBaseAimRotation();
+	Snapshot.ActorRotation = ShooterCharacter->GetActorRotation();
+	Snapshot.bIsFalling = Movement->IsFalling();
+	Snapshot.bIsAccelerating = Movement->GetCurrentAcceleration().Size() > 0.f;
+	Snapshot.bAiming = ShooterCharacter->GetAiming();
+	Snapshot.bCrouching = ShooterCharacter->GetCrouching();
+	Snapshot.bReloading = CombatState == ECombatState::ECS_Reloading;
+	Snapshot.bEquipping = CombatState == ECombatState::ECS_Equipping;
+	Snapshot.bShouldUseFABRIK = CombatState == ECombatState::ECS_Unoccupied || CombatState == ECombatState::ECS_FireTimerInProgress;
+
+	if (const AWeapon* EquippedWeapon{ ShooterCharacter->GetEquippedWeapon() })
+	{
+		Snapshot.bHasEquippedWeapon = true;
+		Snapshot.EquippedWeaponType = EquippedWeapon->GetWeaponType();
+	}
+}
+
+void FShooterAnimInstanceProxy::Update(float DeltaSeconds)
+{
+	SHOOTER_SCOPE_CYCLE_COUNTER(UpdateAnimationProperties);
+
+	Super::Update(DeltaSeconds);
+
+	if (ShooterAnimInstance == nullptr || !Snapshot.bHasCharacter) return;
+
+	UpdateMovement(*ShooterAnimInstance);
+	TurnInPlace(*ShooterAnimInstance);
+	Lean(*ShooterAnimInstance, DeltaSeconds);
+}
+
+void FShooterAnimInstanceProxy::UpdateMovement(UShooterAnimInstance& Instance) const
+{
+	Instance.bCrouching = Snapshot.bCrouching;
+	Instance.bReloading = Snapshot.bReloading;
+	Instance.bEquipping = Snapshot.bEquipping;
+	Instance.bShouldUseFABRIK = Snapshot.bShouldUseFABRIK;
+
+	//Get the lateral speed of the character from Velocity
+	FVector LateralVelocity{ Snapshot.Velocity };
+	LateralVelocity.Z = 0;
+	Instance.Speed = LateralVelocity.Size();
+
+	Instance.bIsInAir = Snapshot.bIsFalling;
+	Instance.bIsAccelerating = Snapshot.bIsAccelerating;
+
+	const FRotator MovementRotation{ UKismetMathLibrary::MakeRotFromX(Snapshot.Velocity) };
+	Instance.MovementOffsetYaw = UKismetMathLibrary::NormalizedDeltaRotator(MovementRotation, Snapshot.AimRotation).Yaw;
+	if (Snapshot.Velocity.Size() > 0.f)
+	{
+		Instance.LastMovementOffsetYaw = Instance.MovementOffsetYaw;
+	}
+	Instance.bAiming = Snapshot.bAiming;
+
+	if (Instance.bReloading)
+	{
+		Instance.OffsetState = EOffsetState::EOS_Reloading;
+	}
+	else if (Instance.bIsInAir)
+	{
+		Instance.OffsetState = EOffsetState::EOS_InAir;
+	}
+	else if (Instance.bAiming)
+	{
+		Instance.OffsetState = EOffsetState::EOS_Aiming;
+	}
+	else
+	{
+		Instance.OffsetState = EOffsetState::EOS_Hip;
+	}
+
+	if (Snapshot.bHasEquippedWeapon)
+	{
+		Instance.EquippedWeaponType = Snapshot.EquippedWeaponType;
+	}
+}
+
+void FShooterAnimInstanceProxy::TurnInPlace(UShooterAnimInstance& Instance)
+{
+	Instance.Pitch = Snapshot.AimRotation.Pitch;
+
+	if (Instance.Speed > 0 || Instance.bIsInAir)
+	{
+		// Don't want to turn in place; Character is moving
+		Instance.RootYawOffset = 0;
+		TIPCharacterYaw = Snapshot.ActorRotation.Yaw;
+		TIPCharacterYawLastFrame = TIPCharacterYaw;
+		RotationCurveLastFrame = 0;
+		RotationCurve = 0;
+	}
+	else
+	{
+		TIPCharacterYawLastFrame = TIPCharacterYaw;
+		TIPCharacterYaw = Snapshot.ActorRotation.Yaw;
+		const float TIPYawDelta{ TIPCharacterYaw - TIPCharacterYawLastFrame };
+
+		// RootYawOffset updated and clamped [-180, 180]
+		float RootYawOffset{ UKismetMathLibrary::NormalizeAxis(Instance.RootYawOffset - TIPYawDelta) };
+
+		// 1.0 if turning, 0.0 if not
+		const float Turning{ GetCurveValue(TEXT("Turning")) };
+		if (Turning > 0)
+		{
+			Instance.bTurningInPlace = true;
+
+			RotationCurveLastFrame = RotationCurve;
+			RotationCurve = GetCurveValue(TEXT("Rotation"));
+			const float DeltaRotation{ RotationCurve - RotationCurveLastFrame };
+
+			// if RootYawOffset is positive we are turning left, if negative we are turning right
+			RootYawOffset > 0 ? RootYawOffset -= DeltaRotation : RootYawOffset += DeltaRotation;
+
+			const float ABSRootYawOffset{ FMath::Abs(RootYawOffset) };
+			if (ABSRootYawOffset > 90.f)
+			{
+				const float YawExcess{ ABSRootYawOffset - 90.f };
+				RootYawOffset > 0 ? RootYawOffset -= YawExcess : RootYawOffset += YawExcess;
+			}
+		}
+		else
+		{
+			Instance.bTurningInPlace = false;
+		}
+		Instance.RootYawOffset = RootYawOffset;
+	}
+
+	// Set the recoil weight
+	const bool bReloading{ Instance.bReloading };
+	const bool bEquipping{ Instance.bEquipping };
+	if (Instance.bTurningInPlace)
+	{
+		if (bReloading || bEquipping)
+		{
+			Instance.RecoilWeight = 1.f;
+		}
+		if (bReloading)
+		{
+			Instance.RecoilWeight = 0.f;
+		}
+	}
+	else if (Instance.bCrouching)
+	{
+		Instance.RecoilWeight = bReloading || bEquipping ? 1.f : 0.1f;
+	}
+	else
+	{
+		Instance.RecoilWeight = Instance.bAiming || bReloading || bEquipping ? 1.f : 0.5f;
+	}
+}
+
+void FShooterAnimInstanceProxy::Lean(UShooterAnimInstance& Instance, float DeltaSeconds)
+{
+	CharacterRotationLastFrame = CharacterRotation;
+	CharacterRotation = Snapshot.ActorRotation;
+	if (DeltaSeconds <= 0.f) return;
+
+	const FRotator Delta{ UKismetMathLibrary::NormalizedDeltaRotator(CharacterRotation, CharacterRotationLastFrame) };
+
+	const float Target{ float(Delta.Yaw) / DeltaSeconds };
+	const float Interp{ FMath::FInterpTo(Instance.YawDelta, Target, DeltaSeconds, 6.f) };
+	Instance.YawDelta = FMath::Clamp(Interp, -90.f, 90.f);
+}
+
+float FShooterAnimInstanceProxy::GetCurveValue(FName CurveName) const
+{
+	const float* Value{ GetAnimationCurves(EAnimCurveType::AttributeCurve).Find(CurveName) };
+	return Value ? *Value : 0.f;
+}
@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "WeaponType.h"
+#include "ShooterAnimInstanceProxy.generated.h"
+
+class UShooterAnimInstance;
+
+/** Everything the shooter anim update reads from the character, copied on the game thread */
+struct FShooterAnimSnapshot
+{
+	FVector Velocity{ 0.f };
+	FRotator AimRotation{ 0.f };
+	FRotator ActorRotation{ 0.f };
+	EWeaponType EquippedWeaponType{ EWeaponType::EWT_MAX };
+	bool bHasCharacter{ false };
+	bool bHasEquippedWeapon{ false };
+	bool bIsFalling{ false };
+	bool bIsAccelerating{ false };
+	bool bAiming{ false };
+	bool bCrouching{ false };
+	bool bReloading{ false };
+	bool bEquipping{ false };
+	/** Unoccupied or between shots, so the left hand can stay on the weapon */
+	bool bShouldUseFABRIK{ false };
+};
+
+/**
+ * Runs UShooterAnimInstance's update on the animation worker threads.
+ * PreUpdate copies the character into a snapshot on the game thread; Update computes
+ * speed, offset state, turn in place, lean and recoil weight from the snapshot alone.
+ */
+USTRUCT()
+struct SHOOTER_API FShooterAnimInstanceProxy : public FAnimInstanceProxy
+{
+	GENERATED_BODY()
+
+public:
+	FShooterAnimInstanceProxy() = default;
+	explicit FShooterAnimInstanceProxy(UAnimInstance* InAnimInstance);
+
+protected:
+	virtual void Initialize(UAnimInstance* InAnimInstance) override;
+	virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override;
+	virtual void Update(float DeltaSeconds) override;
+
+private:
+	/** Speed, air and acceleration state, strafing offset and offset state */
+	void UpdateMovement(UShooterAnimInstance& Instance) const;
+
+	/** Handle turning in place variables and the recoil weight */
+	void TurnInPlace(UShooterAnimInstance& Instance);
+
+	/** Handle calculations for leaning while running */
+	void Lean(UShooterAnimInstance& Instance, float DeltaSeconds);
+
+	/** Curve value from the last evaluation; 0 if the curve isn't there */
+	float GetCurveValue(FName CurveName) const;
+
+	UShooterAnimInstance* ShooterAnimInstance{ nullptr };
+
+	FShooterAnimSnapshot Snapshot;
+
+	/** Yaw of the Character this frame; Only updated standing still and not in air */
+	float TIPCharacterYaw{ 0.f };
+
+	/** Yaw of the Character the previous frame */
+	float TIPCharacterYawLastFrame{ 0.f };
+
+	/** Rotation curve value this frame */
+	float RotationCurve{ 0.f };
+
+	/** Rotation curve value last frame */
+	float RotationCurveLastFrame{ 0.f };
+
+	/** Character rotation this frame and last frame, for leaning */
+	FRotator CharacterRotation{ 0.f };
+	FRotator CharacterRotationLastFrame{ 0.f };
+};
@@ -0,0 +1,204 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ShooterAudioSubsystem.h"
+#include "Kismet/GameplayStatics.h"
+#include "Sound/SoundBase.h"
+#include "Components/AudioComponent.h"
+#include "AudioDevice.h"
+
+UShooterAudioSubsystem::UShooterAudioSubsystem() :
+	MaxVoicesPerCue(4),
+	MaxVoiceDuration(2.f),
+	MergeWindow(0.05f),
+	MergeDistance(100.f)
+{
+}
+
+bool UShooterAudioSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UShooterAudioSubsystem::PlaySound2D(USoundBase* Sound, bool bStealOldestVoice)
+{
+	if (Sound == nullptr) return false;
+
+	FVoice* Voice{ TryStartVoice(Sound, FVector::ZeroVector, false, bStealOldestVoice) };
+	if (Voice == nullptr) return false;
+
+	if (bStealOldestVoice)
+	{
+		// Keep the component, so the play that steals this voice can stop it
+		Voice->AudioComponent = UGameplayStatics::SpawnSound2D(GetWorld(), Sound);
+	}
+	else
+	{
+		UGameplayStatics::PlaySound2D(GetWorld(), Sound);
+	}
+	return true;
+}
+
+bool UShooterAudioSubsystem::PlaySoundAtLocation(USoundBase* Sound, const FVector& Location)
+{
+	if (Sound == nullptr) return false;
+
+	// Cull before the cue takes a voice or the engine creates an active sound
+	FAudioDeviceHandle AudioDevice{ GetWorld()->GetAudioDevice() };
+	if (AudioDevice && !AudioDevice->LocationIsAudible(Location, Sound->GetMaxDistance()))
+	{
+		NumDroppedSounds++;
+		return false;
+	}
+	if (TryStartVoice(Sound, Location, true) == nullptr) return false;
+
+	UGameplayStatics::PlaySoundAtLocation(GetWorld(), Sound, Location);
+	return true;
+}
+
+bool UShooterAudioSubsystem::PlayDebouncedSound2D(USoundBase* Sound, const UObject* Owner, FName Group, float DebounceTime, bool bForce)
+{
+	if (!bForce)
+	{
+		const double Now{ GetWorld()->GetTimeSeconds() };
+		double& DebounceEndTime{ DebounceEndTimes.FindOrAdd(TPair<FObjectKey, FName>(Owner, Group), TNumericLimits<double>::Lowest()) };
+		if (Now < DebounceEndTime) return false;
+
+		DebounceEndTime = Now + DebounceTime;
+	}
+	return PlaySound2D(Sound);
+}
+
+void UShooterAudioSubsystem::PlaySound2D(const UWorld* World, USoundBase* Sound, bool bStealOldestVoice)
+{
+	if (World == nullptr || Sound == nullptr) return;
+
+	UShooterAudioSubsystem* Audio{ World->GetSubsystem<UShooterAudioSubsystem>() };
+	if (Audio)
+	{
+		Audio->PlaySound2D(Sound, bStealOldestVoice);
+	}
+	else
+	{
+		UGameplayStatics::PlaySound2D(World, Sound);
+	}
+}
+
+void UShooterAudioSubsystem::PlaySoundAtLocation(const UWorld* World, USoundBase* Sound, const FVector& Location)
+{
+	if (World == nullptr || Sound == nullptr) return;
+
+	UShooterAudioSubsystem* Audio{ World->GetSubsystem<UShooterAudioSubsystem>() };
+	if (Audio)
+	{
+		Audio->PlaySoundAtLocation(Sound, Location);
+	}
+	else
+	{
+		UGameplayStatics::PlaySoundAtLocation(World, Sound, Location);
+	}
+}
+
+void UShooterAudioSubsystem::PlayDebouncedSound2D(const UWorld* World, USoundBase* Sound, const UObject* Owner, FName Group, float DebounceTime, bool bForce)
+{
+	if (World == nullptr || Sound == nullptr) return;
+
+	UShooterAudioSubsystem* Audio{ World->GetSubsystem<UShooterAudioSubsystem>() };
+	if (Audio)
+	{
+		Audio->PlayDebouncedSound2D(Sound, Owner, Group, DebounceTime, bForce);
+	}
+	else
+	{
+		UGameplayStatics::PlaySound2D(World, Sound);
+	}
+}
+
+UShooterAudioSubsystem::FVoice* UShooterAudioSubsystem::TryStartVoice(USoundBase* Sound, const FVector& Location, bool bSpatialized, bool bStealOldestVoice)
+{
+	const double Now{ GetWorld()->GetTimeSeconds() };
+	if (Now >= NextPruneTime)
+	{
+		PruneExpired(Now);
+		NextPruneTime = Now + PruneInterval;
+	}
+
+	TArray<FVoice, TInlineAllocator<8>>& Voices{ CueVoices.FindOrAdd(Sound) };
+
+	// Forget voices that have finished and are too old to merge with
+	Voices.RemoveAllSwap([Now, this](const FVoice& Voice)
+		{
+			return Voice.EndTime <= Now && Now - Voice.StartTime > MergeWindow;
+		}, false);
+
+	int32 NumPlaying{ 0 };
+	int32 OldestPlaying{ INDEX_NONE };
+	int32 OldestStoppable{ INDEX_NONE };
+	for (int32 i = 0; i < Voices.Num(); i++)
+	{
+		const FVoice& Voice{ Voices[i] };
+		if (Now - Voice.StartTime <= MergeWindow &&
+			(!bSpatialized || FVector::DistSquared(Voice.Location, Location) <= FMath::Square(MergeDistance)))
+		{
+			// Identical sound just started here; one is enough
+			NumDroppedSounds++;
+			return nullptr;
+		}
+		if (Voice.EndTime > Now)
+		{
+			NumPlaying++;
+			if (OldestPlaying == INDEX_NONE || Voice.StartTime < Voices[OldestPlaying].StartTime)
+			{
+				OldestPlaying = i;
+			}
+			if (Voice.AudioComponent.IsValid() && (OldestStoppable == INDEX_NONE || Voice.StartTime < Voices[OldestStoppable].StartTime))
+			{
+				OldestStoppable = i;
+			}
+		}
+	}
+	if (NumPlaying >= MaxVoicesPerCue)
+	{
+		if (!bStealOldestVoice)
+		{
+			NumDroppedSounds++;
+			return nullptr;
+		}
+		// The oldest play is closest to its tail, so it gives up its slot. Prefer one that can actually be stopped
+		const int32 StolenVoice{ OldestStoppable != INDEX_NONE ? OldestStoppable : OldestPlaying };
+		if (UAudioComponent* StolenComponent{ Voices[StolenVoice].AudioComponent.Get() })
+		{
+			StolenComponent->Stop();
+		}
+		Voices.RemoveAtSwap(StolenVoice, 1, false);
+	}
+
+	FVoice& Voice{ Voices.AddDefaulted_GetRef() };
+	Voice.Location = Location;
+	Voice.StartTime = Now;
+	Voice.EndTime = Now + FMath::Min(Sound->GetDuration(), MaxVoiceDuration);
+	return &Voice;
+}
+
+void UShooterAudioSubsystem::PruneExpired(double Now)
+{
+	for (auto It = CueVoices.CreateIterator(); It; ++It)
+	{
+		It.Value().RemoveAllSwap([Now, this](const FVoice& Voice)
+			{
+				return Voice.EndTime <= Now && Now - Voice.StartTime > MergeWindow;
+			}, false);
+		if (It.Value().Num() == 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	for (auto It = DebounceEndTimes.CreateIterator(); It; ++It)
+	{
+		if (It.Value() <= Now)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "ShooterAudioSubsystem.generated.h"
+
+class USoundBase;
+class UAudioComponent;
+
+/**
+ * Single entry point for gameplay one-shot sounds.
+ * Before a sound is started it is dropped when it can't be heard from the listener, when the
+ * same cue already played nearby within the merge window, or when the cue is out of voices.
+ * Sounds that must not be starved, like the local player's own gunfire, take the oldest voice instead.
+ * Sounds can also be debounced per owner and group, e.g. a character's pickup sounds.
+ */
+UCLASS(Config = Game)
+class SHOOTER_API UShooterAudioSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UShooterAudioSubsystem();
+
+	/** Play a non-spatialized sound. Returns false if it was dropped. bStealOldestVoice plays it even when the cue is out of voices */
+	bool PlaySound2D(USoundBase* Sound, bool bStealOldestVoice = false);
+
+	/** Play a spatialized sound. Returns false if it was dropped */
+	bool PlaySoundAtLocation(USoundBase* Sound, const FVector& Location);
+
+	/**
+	 * Play a non-spatialized sound unless Owner played a sound in the same Group within the last
+	 * DebounceTime seconds. bForce plays it regardless, without restarting the debounce.
+	 */
+	bool PlayDebouncedSound2D(USoundBase* Sound, const UObject* Owner, FName Group, float DebounceTime, bool bForce = false);
+
+	/** Play through the world's audio subsystem, or play the sound directly in worlds that don't have one */
+	static void PlaySound2D(const UWorld* World, USoundBase* Sound, bool bStealOldestVoice = false);
+	static void PlaySoundAtLocation(const UWorld* World, USoundBase* Sound, const FVector& Location);
+	static void PlayDebouncedSound2D(const UWorld* World, USoundBase* Sound, const UObject* Owner, FName Group, float DebounceTime, bool bForce = false);
+
+	FORCEINLINE int32 GetNumDroppedSounds() const { return NumDroppedSounds; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FVoice
+	{
+		FVector Location{ FVector::ZeroVector };
+		double StartTime{ 0.0 };
+		double EndTime{ 0.0 };
+
+		/** Only kept for plays that may steal a voice, so a later steal can stop them */
+		TWeakObjectPtr<UAudioComponent> AudioComponent;
+	};
+
+	/**
+	 * Reserve a voice for the cue, or return nullptr if the sound should be dropped.
+	 * The voice is only valid until the next call.
+	 */
+	FVoice* TryStartVoice(USoundBase* Sound, const FVector& Location, bool bSpatialized, bool bStealOldestVoice = false);
+
+	/** Drop finished voices of every cue and expired debounces, so neither map grows with each new cue or owner */
+	void PruneExpired(double Now);
+
+	/** Voices started per cue, and still playing or started within the merge window */
+	TMap<FObjectKey, TArray<FVoice, TInlineAllocator<8>>> CueVoices;
+
+	/** World time until which each (owner, group) is debounced */
+	TMap<TPair<FObjectKey, FName>, double> DebounceEndTimes;
+
+	double NextPruneTime{ 0.0 };
+
+	/** Seconds between sweeps of CueVoices and DebounceEndTimes */
+	static constexpr double PruneInterval{ 5.0 };
+
+	/** Voices one cue can have playing at once */
+	UPROPERTY(Config, EditAnywhere, Category = Budget)
+	int32 MaxVoicesPerCue;
+
+	/** Seconds a voice holds its slot, at most. Looping and very long cues count as this long */
+	UPROPERTY(Config, EditAnywhere, Category = Budget)
+	float MaxVoiceDuration;
+
+	/** The same cue started within this many seconds... */
+	UPROPERTY(Config, EditAnywhere, Category = Merging)
+	float MergeWindow;
+
+	/** ...and this distance of another play of it is merged into that one */
+	UPROPERTY(Config, EditAnywhere, Category = Merging)
+	float MergeDistance;
+
+	int32 NumDroppedSounds{ 0 };
+};
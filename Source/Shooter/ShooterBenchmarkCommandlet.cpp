@@ -0,0 +1,517 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ShooterBenchmarkCommandlet.h"
+#include "ShooterCharacter.h"
+#include "ShooterCounters.h"
+#include "ShooterStats.h"
+#include "Enemy.h"
+#include "Weapon.h"
+#include "Ammo.h"
+#include "ItemPoolSubsystem.h"
+#include "EnemyStateSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Components/BoxComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/InputComponent.h"
+#include "HAL/MemoryBase.h"
+#include "Templates/TypeCompatibleBytes.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogShooterBenchmark, Log, All);
+
+namespace
+{
+	/** Forwards to the real allocator and counts allocations */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			NumAllocations.fetch_add(1, std::memory_order_relaxed);
+			return Inner->Malloc(Count, Alignment);
+		}
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			NumAllocations.fetch_add(1, std::memory_order_relaxed);
+			return Inner->TryMalloc(Count, Alignment);
+		}
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			NumAllocations.fetch_add(1, std::memory_order_relaxed);
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			NumAllocations.fetch_add(1, std::memory_order_relaxed);
+			return Inner->TryRealloc(Original, Count, Alignment);
+		}
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void InitializeStatsMetadata() override { Inner->InitializeStatsMetadata(); }
+		virtual void UpdateStats() override { Inner->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return TEXT("ShooterBenchmarkCountingMalloc"); }
+
+		uint64 GetNumAllocations() const { return NumAllocations.load(std::memory_order_relaxed); }
+
+	private:
+		FMalloc* Inner;
+		std::atomic<uint64> NumAllocations{ 0 };
+	};
+
+	/**
+	 * Wrap GMalloc in the counting allocator, once per process. The wrapper is never removed or destroyed:
+	 * worker threads that read GMalloc before the swap keep calling the real allocator, ones that read it
+	 * after go through the wrapper to the same allocator, and either may free blocks the other allocated.
+	 */
+	FCountingMalloc& InstallCountingMalloc()
+	{
+		static TTypeCompatibleBytes<FCountingMalloc> Storage;
+		static FCountingMalloc* CountingMalloc{ nullptr };
+		if (CountingMalloc == nullptr)
+		{
+			CountingMalloc = new (&Storage) FCountingMalloc(GMalloc);
+			// Publish the fully constructed wrapper before other threads can pick it up
+			FPlatformMisc::MemoryBarrier();
+			GMalloc = CountingMalloc;
+		}
+		return *CountingMalloc;
+	}
+
+	/** Fire every binding of an input action, the way the player controller does for a key event */
+	void ExecuteInputAction(UInputComponent* Input, FName ActionName, EInputEvent KeyEvent)
+	{
+		for (int32 i = 0; i < Input->GetNumActionBindings(); i++)
+		{
+			const FInputActionBinding& Binding{ Input->GetActionBinding(i) };
+			if (Binding.GetActionName() == ActionName && Binding.KeyEvent == KeyEvent)
+			{
+				Binding.ActionDelegate.Execute(EKeys::Invalid);
+			}
+		}
+	}
+
+	/** Call a parameterless BlueprintCallable function the way an anim notify event graph does */
+	bool CallBlueprintFunction(UObject* Object, FName FunctionName)
+	{
+		UFunction* Function{ Object->FindFunction(FunctionName) };
+		if (Function == nullptr) return false;
+
+		Object->ProcessEvent(Function, nullptr);
+		return true;
+	}
+
+	/** Value at Percentile (0-1) of an already sorted array */
+	double GetPercentile(const TArray<double>& Sorted, double Percentile)
+	{
+		if (Sorted.Num() == 0) return 0.0;
+		const int32 Index{ FMath::Clamp(FMath::CeilToInt(Percentile * Sorted.Num()) - 1, 0, Sorted.Num() - 1) };
+		return Sorted[Index];
+	}
+
+	/** Load a class from a -Name=/Game/Path command line switch, or fall back to the native class */
+	template<typename T>
+	TSubclassOf<T> LoadClassParam(const FString& Params, const TCHAR* Switch, TSubclassOf<T> Fallback)
+	{
+		FString ClassPath;
+		if (!FParse::Value(*Params, Switch, ClassPath)) return Fallback;
+
+		UClass* Class{ LoadClass<T>(nullptr, *ClassPath) };
+		if (Class == nullptr)
+		{
+			UE_LOG(LogShooterBenchmark, Warning, TEXT("Couldn't load %s%s, using %s"), Switch, *ClassPath, *Fallback->GetName());
+			return Fallback;
+		}
+		return Class;
+	}
+
+	/** Chance per frame of each scripted action */
+	constexpr float FireChance{ 0.05f };
+	constexpr float ReleaseFireChance{ 0.03f };
+	constexpr float ReloadChance{ 0.005f };
+	constexpr float PickupChance{ 0.002f };
+
+	/** Share of scripted pickups that are ammo rather than weapons */
+	constexpr float AmmoPickupShare{ 0.5f };
+	constexpr float MeleeChance{ 0.01f };
+
+	/** Frames before a montage-driven state is released by the script */
+	constexpr int32 StuckStateFrames{ 60 };
+
+	/** Distance an enemy has to be within to land a scripted melee hit */
+	constexpr float MeleeRange{ 300.f };
+
+	/** Subobject name of the enemy's left weapon collision box */
+	const FName LeftWeaponBoxName{ TEXT("Left Weapon Box") };
+}
+
+UShooterBenchmarkCommandlet::UShooterBenchmarkCommandlet() :
+	ArenaSize(10'000.f)
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UShooterBenchmarkCommandlet::Main(const FString& Params)
+{
+	int32 NumCharacters{ 4 };
+	int32 NumEnemies{ 64 };
+	int32 NumFrames{ 1800 };
+	int32 Seed{ 1 };
+	FParse::Value(*Params, TEXT("Characters="), NumCharacters);
+	FParse::Value(*Params, TEXT("Enemies="), NumEnemies);
+	FParse::Value(*Params, TEXT("Frames="), NumFrames);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("ArenaSize="), ArenaSize);
+	const bool bCountAllocations{ !FParse::Param(*Params, TEXT("NoAllocCount")) };
+
+	// Fixed step so runs with the same seed simulate the same thing
+	constexpr float DeltaTime{ 1.f / 60.f };
+
+	const TSubclassOf<AShooterCharacter> CharacterClass{ LoadClassParam<AShooterCharacter>(Params, TEXT("CharacterClass="), AShooterCharacter::StaticClass()) };
+	const TSubclassOf<AEnemy> EnemyClass{ LoadClassParam<AEnemy>(Params, TEXT("EnemyClass="), AEnemy::StaticClass()) };
+	WeaponClass = LoadClassParam<AWeapon>(Params, TEXT("WeaponClass="), AWeapon::StaticClass());
+	AmmoClass = LoadClassParam<AAmmo>(Params, TEXT("AmmoClass="), AAmmo::StaticClass());
+
+	Random.Initialize(Seed);
+
+	// Fresh game world
+	UWorld* World{ UWorld::CreateWorld(EWorldType::Game, false, TEXT("ShooterBenchmark")) };
+	FWorldContext& WorldContext{ GEngine->CreateNewWorldContext(EWorldType::Game) };
+	WorldContext.SetCurrentWorld(World);
+	World->SetGameMode(FURL());
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	SpawnArena(World);
+
+	for (int32 i = 0; i < NumCharacters; i++)
+	{
+		const FTransform SpawnTransform{ FRotator(0.f, Random.FRandRange(-180.f, 180.f), 0.f), RandomArenaLocation() + FVector(0.f, 0.f, 100.f) };
+		AShooterCharacter* Character{ World->SpawnActorDeferred<AShooterCharacter>(CharacterClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn) };
+		if (Character == nullptr) continue;
+
+		// BeginPlay equips the default weapon, so fill it in like a Blueprint default before spawning finishes
+		FClassProperty* DefaultWeaponProperty{ FindFProperty<FClassProperty>(AShooterCharacter::StaticClass(), TEXT("DefaultWeaponClass")) };
+		if (DefaultWeaponProperty && DefaultWeaponProperty->GetPropertyValue_InContainer(Character) == nullptr)
+		{
+			DefaultWeaponProperty->SetPropertyValue_InContainer(Character, WeaponClass.Get());
+		}
+		Character->FinishSpawning(SpawnTransform);
+
+		// Same bindings a possessing player controller would set up
+		UInputComponent* Input{ NewObject<UInputComponent>(Character) };
+		Character->SetupPlayerInputComponent(Input);
+		Characters.Add(Character);
+		CharacterInputs.Add(Input);
+	}
+	FramesInState.Init(0, Characters.Num());
+
+	for (int32 i = 0; i < NumEnemies; i++)
+	{
+		const FTransform SpawnTransform{ FRotator(0.f, Random.FRandRange(-180.f, 180.f), 0.f), RandomArenaLocation() + FVector(0.f, 0.f, 100.f) };
+		AEnemy* Enemy{ World->SpawnActor<AEnemy>(EnemyClass, SpawnTransform) };
+		if (Enemy == nullptr) continue;
+
+		if (Enemy->GetController() == nullptr)
+		{
+			Enemy->SpawnDefaultController();
+		}
+		Enemies.Add(Enemy);
+	}
+
+	UE_LOG(LogShooterBenchmark, Display, TEXT("Simulating %d frames: %d characters (%s), %d enemies (%s), seed %d"),
+		NumFrames, Characters.Num(), *CharacterClass->GetName(), Enemies.Num(), *EnemyClass->GetName(), Seed);
+
+	// Counts allocations from every thread, including task graph workers running parts of the frame
+	const FCountingMalloc* CountingMalloc{ bCountAllocations ? &InstallCountingMalloc() : nullptr };
+
+	TArray<double> FrameTimes;
+	TArray<double> FrameAllocations;
+	FrameTimes.Reserve(NumFrames);
+	FrameAllocations.Reserve(NumFrames);
+
+	const uint64 StartTraces{ ShooterCounters::NumTraces.load() };
+	const uint64 StartDamageEvents{ ShooterCounters::NumDamageEvents.load() };
+
+#if CSV_PROFILER
+	// Per-frame capture of the Shooter stats, for diffing between builds
+	FString CsvFilename;
+	const bool bCsvCapture{ FParse::Value(*Params, TEXT("CsvCapture="), CsvFilename) };
+	if (bCsvCapture)
+	{
+		FCsvProfiler::Get()->BeginCapture(-1, FString(), CsvFilename);
+	}
+#endif
+
+	for (int32 Frame = 0; Frame < NumFrames; Frame++)
+	{
+		const uint64 StartAllocations{ CountingMalloc ? CountingMalloc->GetNumAllocations() : 0 };
+		const double StartTime{ FPlatformTime::Seconds() };
+
+#if CSV_PROFILER
+		// Nothing else drives the CSV profiler's frames in a commandlet
+		FCsvProfiler::Get()->BeginFrame();
+#endif
+		RunScript(World);
+		World->Tick(LEVELTICK_All, DeltaTime);
+		GFrameCounter++;
+#if CSV_PROFILER
+		FCsvProfiler::Get()->EndFrame();
+#endif
+
+		FrameTimes.Add((FPlatformTime::Seconds() - StartTime) * 1000.0);
+		if (CountingMalloc)
+		{
+			FrameAllocations.Add(static_cast<double>(CountingMalloc->GetNumAllocations() - StartAllocations));
+		}
+	}
+
+#if CSV_PROFILER
+	if (bCsvCapture)
+	{
+		// The stop command is processed on the next profiler frame
+		TSharedFuture<FString> CsvPath{ FCsvProfiler::Get()->EndCapture() };
+		FCsvProfiler::Get()->BeginFrame();
+		FCsvProfiler::Get()->EndFrame();
+		UE_LOG(LogShooterBenchmark, Display, TEXT("CSV capture written to %s"), *CsvPath.Get());
+	}
+#endif
+
+	const double SimulatedSeconds{ NumFrames * DeltaTime };
+	const double TracesPerSecond{ (ShooterCounters::NumTraces.load() - StartTraces) / SimulatedSeconds };
+	const double DamageEventsPerSecond{ (ShooterCounters::NumDamageEvents.load() - StartDamageEvents) / SimulatedSeconds };
+
+	FrameTimes.Sort();
+	const double P50{ GetPercentile(FrameTimes, 0.5) };
+	const double P90{ GetPercentile(FrameTimes, 0.9) };
+	const double P99{ GetPercentile(FrameTimes, 0.99) };
+	const double MaxFrameTime{ FrameTimes.Num() > 0 ? FrameTimes.Last() : 0.0 };
+
+	double TotalAllocations{ 0.0 };
+	for (const double Allocations : FrameAllocations)
+	{
+		TotalAllocations += Allocations;
+	}
+	const double AllocationsPerFrame{ FrameAllocations.Num() > 0 ? TotalAllocations / FrameAllocations.Num() : 0.0 };
+	FrameAllocations.Sort();
+	const double P99Allocations{ GetPercentile(FrameAllocations, 0.99) };
+
+	UE_LOG(LogShooterBenchmark, Display, TEXT("Frame time ms: p50 %.3f  p90 %.3f  p99 %.3f  max %.3f"), P50, P90, P99, MaxFrameTime);
+	UE_LOG(LogShooterBenchmark, Display, TEXT("Traces/s: %.1f  Damage events/s: %.1f"), TracesPerSecond, DamageEventsPerSecond);
+
+	// Sanity check that the script actually fought: read straight from the packed enemy state
+	const UEnemyStateSubsystem* EnemyState{ World->GetSubsystem<UEnemyStateSubsystem>() };
+	if (EnemyState)
+	{
+		double HealthLeft{ 0.0 };
+		for (const float Health : EnemyState->GetHealths())
+		{
+			HealthLeft += Health;
+		}
+		UE_LOG(LogShooterBenchmark, Display, TEXT("Enemies: %d of %d dead, %d stunned, %.0f health left"),
+			EnemyState->CountEnemiesWithAnyFlags(EEnemyStateFlags::ESF_Dying), EnemyState->Num(),
+			EnemyState->CountEnemiesWithAnyFlags(EEnemyStateFlags::ESF_Stunned), HealthLeft);
+	}
+	if (CountingMalloc)
+	{
+		UE_LOG(LogShooterBenchmark, Display, TEXT("Allocations/frame: mean %.1f  p99 %.0f"), AllocationsPerFrame, P99Allocations);
+	}
+
+	FString ReportPath;
+	if (FParse::Value(*Params, TEXT("Report="), ReportPath))
+	{
+		const FString Report{ FString::Printf(
+			TEXT("Seed,Characters,Enemies,Frames,P50Ms,P90Ms,P99Ms,MaxMs,TracesPerSecond,DamageEventsPerSecond,AllocationsPerFrame,P99AllocationsPerFrame\n%d,%d,%d,%d,%.3f,%.3f,%.3f,%.3f,%.1f,%.1f,%.1f,%.0f\n"),
+			Seed, Characters.Num(), Enemies.Num(), NumFrames, P50, P90, P99, MaxFrameTime,
+			TracesPerSecond, DamageEventsPerSecond, AllocationsPerFrame, P99Allocations) };
+		FFileHelper::SaveStringToFile(Report, *ReportPath);
+	}
+
+	Characters.Empty();
+	CharacterInputs.Empty();
+	Enemies.Empty();
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return 0;
+}
+
+void UShooterBenchmarkCommandlet::SpawnArena(UWorld* World) const
+{
+	UStaticMesh* PlaneMesh{ LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Plane.Plane")) };
+	AStaticMeshActor* Floor{ World->SpawnActor<AStaticMeshActor>() };
+	if (Floor == nullptr || PlaneMesh == nullptr) return;
+
+	// The plane mesh is 100 x 100 units
+	UStaticMeshComponent* FloorMesh{ Floor->GetStaticMeshComponent() };
+	FloorMesh->SetMobility(EComponentMobility::Movable);
+	FloorMesh->SetStaticMesh(PlaneMesh);
+	FloorMesh->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+	Floor->SetActorScale3D(FVector(ArenaSize / 100.f, ArenaSize / 100.f, 1.f));
+}
+
+void UShooterBenchmarkCommandlet::RunScript(UWorld* World)
+{
+	for (int32 i = 0; i < Characters.Num(); i++)
+	{
+		AShooterCharacter* Character{ Characters[i] };
+		UInputComponent* Input{ CharacterInputs[i] };
+		if (!IsValid(Character)) continue;
+
+		ReleaseStuckStates(Character, i);
+
+		// Face a random enemy before firing so shots can land
+		if (Random.FRand() < FireChance && Enemies.Num() > 0)
+		{
+			const AEnemy* Enemy{ Enemies[Random.RandHelper(Enemies.Num())] };
+			if (IsValid(Enemy))
+			{
+				const FVector ToEnemy{ Enemy->GetActorLocation() - Character->GetActorLocation() };
+				Character->SetActorRotation(FRotator(0.f, ToEnemy.Rotation().Yaw, 0.f));
+			}
+			ExecuteInputAction(Input, TEXT("FireButton"), IE_Pressed);
+		}
+		if (Random.FRand() < ReleaseFireChance)
+		{
+			ExecuteInputAction(Input, TEXT("FireButton"), IE_Released);
+		}
+		if (Random.FRand() < ReloadChance)
+		{
+			ExecuteInputAction(Input, TEXT("ReloadButton"), IE_Pressed);
+		}
+		if (Random.FRand() < PickupChance)
+		{
+			ScriptPickup(World, Character);
+		}
+	}
+
+	for (AEnemy* Enemy : Enemies)
+	{
+		if (!IsValid(Enemy) || Enemy->IsDying() || Characters.Num() == 0) continue;
+		if (Random.FRand() >= MeleeChance) continue;
+
+		AShooterCharacter* Victim{ Characters[Random.RandHelper(Characters.Num())] };
+		if (IsValid(Victim) && FVector::DistSquared(Enemy->GetActorLocation(), Victim->GetActorLocation()) <= FMath::Square(MeleeRange))
+		{
+			ScriptMeleeHit(Enemy, Victim);
+		}
+	}
+}
+
+void UShooterBenchmarkCommandlet::ScriptMeleeHit(AEnemy* Enemy, AShooterCharacter* Victim) const
+{
+	// Without the attack montage nothing sweeps the weapon box into the victim, so raise the overlap it would have
+	TInlineComponentArray<UBoxComponent*> Boxes;
+	Enemy->GetComponents(Boxes);
+	for (UBoxComponent* Box : Boxes)
+	{
+		if (Box->GetFName() == LeftWeaponBoxName)
+		{
+			Box->OnComponentBeginOverlap.Broadcast(Box, Victim, Victim->GetCapsuleComponent(), 0, false, FHitResult());
+			return;
+		}
+	}
+}
+
+void UShooterBenchmarkCommandlet::ScriptPickup(UWorld* World, AShooterCharacter* Character)
+{
+	if (Character->GetCombatState() != ECombatState::ECS_Unoccupied) return;
+
+	UItemPoolSubsystem* ItemPool{ World->GetSubsystem<UItemPoolSubsystem>() };
+	if (ItemPool == nullptr) return;
+
+	ReleaseDroppedWeapons(ItemPool);
+
+	const FTransform SpawnTransform{ Character->GetActorLocation() + Character->GetActorForwardVector() * 150.f };
+	if (Random.FRand() < AmmoPickupShare)
+	{
+		// Ammo isn't pooled; picking it up destroys it, as in the levels
+		AAmmo* Ammo{ World->SpawnActor<AAmmo>(AmmoClass, SpawnTransform) };
+		if (Ammo)
+		{
+			Ammo->StartItemCurve(Character, true);
+		}
+		return;
+	}
+
+	const EItemRarity Rarity{ static_cast<EItemRarity>(Random.RandHelper(static_cast<int32>(EItemRarity::EIR_MAX))) };
+	const EWeaponType WeaponType{ static_cast<EWeaponType>(Random.RandHelper(static_cast<int32>(EWeaponType::EWT_MAX))) };
+	AWeapon* Weapon{ ItemPool->AcquireWeapon(WeaponClass, SpawnTransform, Rarity, WeaponType) };
+	if (Weapon)
+	{
+		ScriptedWeapons.Add(Weapon);
+		Weapon->StartItemCurve(Character, true);
+	}
+}
+
+void UShooterBenchmarkCommandlet::ReleaseDroppedWeapons(UItemPoolSubsystem* ItemPool)
+{
+	for (int32 i = ScriptedWeapons.Num() - 1; i >= 0; i--)
+	{
+		AWeapon* Weapon{ ScriptedWeapons[i] };
+		if (!IsValid(Weapon))
+		{
+			ScriptedWeapons.RemoveAtSwap(i, 1, false);
+		}
+		else if (Weapon->GetItemState() == EItemState::EIS_Pickup)
+		{
+			// Swapped out of an inventory and done falling; nothing else picks it up headless
+			ItemPool->ReleaseItem(Weapon);
+			ScriptedWeapons.RemoveAtSwap(i, 1, false);
+		}
+	}
+}
+
+void UShooterBenchmarkCommandlet::ReleaseStuckStates(AShooterCharacter* Character, int32 CharacterIndex)
+{
+	const ECombatState State{ Character->GetCombatState() };
+	const bool bNotifyDriven{ State == ECombatState::ECS_Reloading || State == ECombatState::ECS_Equipping || State == ECombatState::ECS_Stunned };
+	if (!bNotifyDriven)
+	{
+		FramesInState[CharacterIndex] = 0;
+		return;
+	}
+	if (++FramesInState[CharacterIndex] < StuckStateFrames) return;
+
+	FramesInState[CharacterIndex] = 0;
+
+	// The end-of-montage notifies call these on the character
+	switch (State)
+	{
+	case ECombatState::ECS_Reloading:
+		CallBlueprintFunction(Character, TEXT("FinishReloading"));
+		break;
+	case ECombatState::ECS_Equipping:
+		CallBlueprintFunction(Character, TEXT("FinishEquipping"));
+		break;
+	case ECombatState::ECS_Stunned:
+		CallBlueprintFunction(Character, TEXT("EndStun"));
+		break;
+	default:
+		break;
+	}
+}
+
+FVector UShooterBenchmarkCommandlet::RandomArenaLocation()
+{
+	const float HalfSize{ ArenaSize * 0.5f };
+	return FVector(Random.FRandRange(-HalfSize, HalfSize), Random.FRandRange(-HalfSize, HalfSize), 0.f);
+}
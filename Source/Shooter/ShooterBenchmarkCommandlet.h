@@ -0,0 +1,84 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ShooterBenchmarkCommandlet.generated.h"
+
+class AShooterCharacter;
+class AEnemy;
+class AWeapon;
+class AAmmo;
+class UItemPoolSubsystem;
+class UInputComponent;
+
+/**
+ * Headless combat benchmark. Builds a flat arena in a fresh game world, spawns characters and enemies,
+ * drives firing, reloading, pickups and melee from a seeded script and reports frame time percentiles,
+ * traces and damage events per simulated second and allocations per frame.
+ *
+ * UnrealEditor-Cmd Shooter.uproject -run=ShooterBenchmark -nullrhi -unattended
+ *     [-Characters=4] [-Enemies=64] [-Frames=1800] [-Seed=1] [-ArenaSize=10000]
+ *     [-CharacterClass=/Game/...] [-EnemyClass=/Game/...] [-WeaponClass=/Game/...]
+ *     [-AmmoClass=/Game/...]
+ *     [-Report=Saved/Benchmark.csv] [-CsvCapture=Benchmark.csv] [-NoAllocCount]
+ */
+UCLASS()
+class SHOOTER_API UShooterBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UShooterBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/** Floor the size of the arena, centered on the origin */
+	void SpawnArena(UWorld* World) const;
+
+	/** One frame of scripted input for every character and enemy */
+	void RunScript(UWorld* World);
+
+	/** Spawn a weapon or ammo next to the character and start picking it up */
+	void ScriptPickup(UWorld* World, AShooterCharacter* Character);
+
+	/** Land the enemy's left weapon on the victim, as if its attack montage had swung it */
+	void ScriptMeleeHit(AEnemy* Enemy, AShooterCharacter* Victim) const;
+
+	/** Return scripted weapons that were swapped out and landed back to the pool */
+	void ReleaseDroppedWeapons(UItemPoolSubsystem* ItemPool);
+
+	/** Release anim-notify driven states, since there are no montages to finish them headless */
+	void ReleaseStuckStates(AShooterCharacter* Character, int32 CharacterIndex);
+
+	FVector RandomArenaLocation();
+
+	UPROPERTY()
+	TArray<AShooterCharacter*> Characters;
+
+	/** Input bound by each character, parallel to Characters */
+	UPROPERTY()
+	TArray<UInputComponent*> CharacterInputs;
+
+	UPROPERTY()
+	TArray<AEnemy*> Enemies;
+
+	UPROPERTY()
+	TSubclassOf<AWeapon> WeaponClass;
+
+	UPROPERTY()
+	TSubclassOf<AAmmo> AmmoClass;
+
+	/** Weapons handed out by ScriptPickup that haven't been released yet */
+	UPROPERTY()
+	TArray<AWeapon*> ScriptedWeapons;
+
+	/** Frames each character has spent in its current anim-notify driven state */
+	TArray<int32> FramesInState;
+
+	FRandomStream Random;
+
+	float ArenaSize;
+};
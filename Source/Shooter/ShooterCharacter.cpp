@@ -25,6 +25,18 @@
 #include "BulletHitInterface.h"
 #include "EnemyController.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "HitscanSubsystem.h"
+#include "ItemFocusComponent.h"
+#include "ItemPoolSubsystem.h"
+#include "EffectsPoolSubsystem.h"
+#include "ShooterAudioSubsystem.h"
+#include "CooldownComponent.h"
+#include "ShooterInterp.h"
+#include "ItemGridSubsystem.h"
+#include "ShooterCounters.h"
+#include "ShooterStats.h"
+#include "DamagePipelineSubsystem.h"
+#include "CharacterGridSubsystem.h"
 
 // Sets default values
 AShooterCharacter::AShooterCharacter() :
@@ -56,13 +68,11 @@ AShooterCharacter::AShooterCharacter() :
 	CrosshairShootingFactor(0.f),
 	// Bullet fire timer variable
 	ShootTimeDuration(0.05f),
-	bFiringBullet(false),
 	// Automatic  fire variables
-	bShouldFire(true),
 	bFireButtonPressed(false),
-	//Item trace variables
-	bShouldTraceForItems(false),
-	OverlappedItemCount(0),
+	//Nearby item query variables
+	NearbyItemsQueryInterval(0.1f),
+	NextNearbyItemsQueryTime(0.0),
 	//Camera interp location variables
 	CameraInterpDistance(20.f),
 	CameraInterpElevation(35.f),
@@ -79,9 +89,7 @@ AShooterCharacter::AShooterCharacter() :
 	BaseGroundFriction(2.f),
 	CrouchingGroundFriction(40.f),
 	bAimingButtonPressed(false),
-	//Pickup sound timer properties
-	bShouldPlayPickupSound(true),
-	bShouldPlayEquipSound(true),
+	//Pickup and equip sound debounce times
 	PickupSoundResetTime(0.2f),
 	EquipSoundResetTime(0.2f),
 	//Icon animation property
@@ -141,10 +149,18 @@ AShooterCharacter::AShooterCharacter() :
 	InterpComp6 = CreateDefaultSubobject<USceneComponent>(TEXT("Interpoaltion Component 6"));
 	InterpComp6->SetupAttachment(GetFollowCamera());
 
+	// Create the component that traces for items under the crosshairs
+	ItemFocusComponent = CreateDefaultSubobject<UItemFocusComponent>(TEXT("ItemFocusComponent"));
+
+	Cooldowns = CreateDefaultSubobject<UCooldownComponent>(TEXT("Cooldowns"));
+	CrosshairShootCooldown = Cooldowns->AddCooldown();
+
 }
 
 float AShooterCharacter::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
 {
+	ShooterCounters::NumDamageEvents.fetch_add(1, std::memory_order_relaxed);
+
 	if (Health - DamageAmount <= 0.f)
 	{
 		Health = 0;
@@ -153,10 +169,9 @@ float AShooterCharacter::TakeDamage(float DamageAmount, FDamageEvent const& Dama
 		auto EnemyController = Cast<AEnemyController>(EventInstigator);
 		if (EnemyController)
 		{
-			EnemyController->GetBlackboardComponent()->SetValueAsBool(
-				FName(TEXT("CharacterDead")),
-				true
-			);
+			EnemyController->SetBlackboardBool(
+				EEnemyBlackboardKey::EBK_CharacterDead,
+				true);
 		}
 	}
 	else {
@@ -214,6 +229,43 @@ void AShooterCharacter::BeginPlay()
 
 	// Create FInterLocation structs for eact interp location. Add to array
 	InitializeInterpLocations();
+
+	UCharacterGridSubsystem* CharacterGrid{ GetWorld()->GetSubsystem<UCharacterGridSubsystem>() };
+	if (CharacterGrid)
+	{
+		CharacterGrid->RegisterCharacter(this);
+	}
+
+	// Every shot plays these; create their components before the first one
+	UEffectsPoolSubsystem* EffectsPool{ GetWorld()->GetSubsystem<UEffectsPoolSubsystem>() };
+	if (EffectsPool)
+	{
+		EffectsPool->WarmPool(ImpactParticles);
+		EffectsPool->WarmPool(BeamParticles);
+	}
+}
+
+void AShooterCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UCharacterGridSubsystem* CharacterGrid{ GetWorld()->GetSubsystem<UCharacterGridSubsystem>() };
+	if (CharacterGrid)
+	{
+		CharacterGrid->UnregisterCharacter(this);
+	}
+
+	// Carried weapons would otherwise be left floating where the character was
+	UItemPoolSubsystem* ItemPool{ GetWorld()->GetSubsystem<UItemPoolSubsystem>() };
+	if (ItemPool && EndPlayReason == EEndPlayReason::Destroyed)
+	{
+		for (AItem* Item : Inventory)
+		{
+			ItemPool->ReleaseItem(Item);
+		}
+		Inventory.Empty();
+		EquippedWeapon = nullptr;
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AShooterCharacter::MoveForward(float Value)
@@ -284,13 +336,21 @@ void AShooterCharacter::LookUp(float Value)
 
 void AShooterCharacter::FireWeapon()
 {
+	SHOOTER_SCOPE_CYCLE_COUNTER(FireWeapon);
+
 	if (EquippedWeapon == nullptr) return;
 	if (CombatState != ECombatState::ECS_Unoccupied) return;
 	
 	if(WeaponHasAmmo())
 	{
 		PlayFireSound();
-		SendBullet();
+		FTransform MuzzleTransform;
+		if (GetBarrelSocketTransform(MuzzleTransform))
+		{
+			SendBullet(MuzzleTransform, true);
+			LastMuzzleTransform = MuzzleTransform;
+			LastMuzzleTime = GetWorld()->GetTimeSeconds();
+		}
 		PlayGunFireMontage();
 
 		// Start bullet fire timer for crosshairs
@@ -298,7 +358,7 @@ void AShooterCharacter::FireWeapon()
 		// Subtract 1 from Weapon's Ammo 
 		EquippedWeapon->DecrementAmmo();
 
-		StartFireTimer();
+		StartFireTimer(GetWorld()->GetTimeSeconds());
 	
 		if (EquippedWeapon->GetWeaponType() == EWeaponType::EWT_Pistol)
 		{
@@ -308,42 +368,6 @@ void AShooterCharacter::FireWeapon()
 	}
 }
 
-bool AShooterCharacter::GetBeamEndLocation(
-	const FVector& MuzzleSocketLocation,
-	FHitResult& OutHitResult)
-{
-	FVector OutBeamLocation;
-	// Check for crosshair hit
-	FHitResult CrosshairHitResult;
-	bool bCrosshairHit = TraceUnderCrosshairs(CrosshairHitResult, OutBeamLocation);
-
-	if (bCrosshairHit)
-	{
-		//Tentative beam location - still need to trace from gun
-		OutBeamLocation = CrosshairHitResult.Location;
-	}
-	else  // no crosshair trace hit
-	{
-		// OutBeamLocation is the End location for the line trace
-	}
-	
-	// Perform trace from gun barrel
-	const FVector WeaponTraceStart{ MuzzleSocketLocation};
-	const FVector StartToEnd{ OutBeamLocation - MuzzleSocketLocation};
-	const FVector WeaponTraceEnd{StartToEnd * 1.25f + MuzzleSocketLocation};
-	GetWorld()->LineTraceSingleByChannel(
-		OutHitResult,
-		WeaponTraceStart,
-		WeaponTraceEnd,
-		ECollisionChannel::ECC_Visibility);
-	if(!OutHitResult.bBlockingHit) // Object between barrel and BeamEndPoint?
-	{
-		OutHitResult.Location = OutBeamLocation;
-		return false;
-	}
-	return true;
-}
-
 void AShooterCharacter::AimingButtonPressed()
 {
 	bAimingButtonPressed = true;
@@ -359,31 +383,6 @@ void AShooterCharacter::AimingButtonReleased()
 	StopAiming();
 }
 
-void AShooterCharacter::SetSmoothAim(float DeltaTime)
-{
-	// Set current camera field of view
-	if(bAiming)
-	{
-		//Interpolate to zoomed fov
-		CameraCurrentFOV = FMath::FInterpTo(
-			CameraCurrentFOV,
-			CameraZoomedFOV,
-			DeltaTime,
-			ZoomInterpSpeed);
-	}
-	else
-	{
-		//Interpolate to Default fov
-
-		CameraCurrentFOV = FMath::FInterpTo(
-			CameraCurrentFOV,
-			CameraDefaultFOV,
-			DeltaTime,
-			ZoomInterpSpeed);
-	}
-	GetFollowCamera()->SetFieldOfView(CameraCurrentFOV);
-}
-
 void AShooterCharacter::SetLookRates()
 {
 	if(bAiming)
@@ -400,6 +399,8 @@ void AShooterCharacter::SetLookRates()
 
 void AShooterCharacter::CalculateCrosshairSpread(float DeltaTime)
 {
+	SHOOTER_SCOPE_CYCLE_COUNTER(CalculateCrosshairSpread);
+
 	FVector2D WalkSpeedRange{0.f, 600.f};
 	FVector2D VelocityMultiplayerRange{0.f, 1.f};
 	FVector Velocity{GetVelocity()};
@@ -411,61 +412,41 @@ void AShooterCharacter::CalculateCrosshairSpread(float DeltaTime)
 		VelocityMultiplayerRange,
 		Velocity.Size());
 
-	// Calculate crosshair in air factor
-	if(GetCharacterMovement()->IsFalling())// is air ?
-	{
-		//Spread the crosshairs slowly while in air
-		CrosshairInAirFactor = FMath::FInterpTo(
-			CrosshairInAirFactor, 
-			2.25, 
-			DeltaTime, 
-			2.25f);
-	}
-	else // Character is on the ground
-	{
-		// Shrink(küçültmek) the crosshair rapidly(hızlıca) while on the ground 
-		CrosshairInAirFactor = FMath::FInterpTo(
-			CrosshairInAirFactor, 
-			0.5, 
-			DeltaTime, 
-			30.f);
-	}
-
-	if (bAiming) // Are we aiming ?
-	{
-		// Shrink crosshair a small value very quickly
-		CrosshairAimFactor = FMath::FInterpTo(
-			CrosshairAimFactor, 
-			0.6, 
-			DeltaTime, 
-			30.f);
-	}
-	else // Are we  NOT aiming ?
-	{
-		//Spread crosshair back to normal very quickly
-		CrosshairAimFactor = FMath::FInterpTo(
-			CrosshairAimFactor, 
-			0, 
-			DeltaTime, 
-			10.f);
-	}
-
+	const bool bFalling{ GetCharacterMovement()->IsFalling() };
 	// True  0.05 seconds after firing
-	if (bFiringBullet)
-	{
-		CrosshairShootingFactor = FMath::FInterpTo(
-			CrosshairShootingFactor, 
-			0.3f, 
-			DeltaTime, 
-			60.f);
-	}
-	else
-	{
-		CrosshairShootingFactor = FMath::FInterpTo(
-			CrosshairShootingFactor, 
-			0.f, 
-			DeltaTime, 
-			60.f);
+	const bool bShootingRecently{ Cooldowns->IsCoolingDown(CrosshairShootCooldown) };
+
+	// In air, aim and shooting factors and the zoom FOV are interpolated together, one per SIMD lane
+	const VectorRegister4Float CurrentFactors{ VectorSet(
+		CrosshairInAirFactor,
+		CrosshairAimFactor,
+		CrosshairShootingFactor,
+		CameraCurrentFOV) };
+	const VectorRegister4Float TargetFactors{ VectorSet(
+		// Spread the crosshairs slowly while in air, shrink them rapidly on the ground
+		bFalling ? 2.25f : 0.5f,
+		// Shrink crosshair a small value very quickly when aiming, spread back to normal otherwise
+		bAiming ? 0.6f : 0.f,
+		bShootingRecently ? 0.3f : 0.f,
+		// Zoom in while aiming, back to the default fov otherwise
+		bAiming ? CameraZoomedFOV : CameraDefaultFOV) };
+	const VectorRegister4Float InterpSpeeds{ VectorSet(
+		bFalling ? 2.25f : 30.f,
+		bAiming ? 30.f : 10.f,
+		60.f,
+		ZoomInterpSpeed) };
+
+	alignas(16) float InterpedFactors[4];
+	VectorStoreAligned(ShooterInterp::InterpTo4(CurrentFactors, TargetFactors, DeltaTime, InterpSpeeds), InterpedFactors);
+	CrosshairInAirFactor = InterpedFactors[0];
+	CrosshairAimFactor = InterpedFactors[1];
+	CrosshairShootingFactor = InterpedFactors[2];
+	if (CameraCurrentFOV != InterpedFactors[3])
+	{
+		CameraCurrentFOV = InterpedFactors[3];
+		GetFollowCamera()->SetFieldOfView(CameraCurrentFOV);
+		// Zooming changes the projection the crosshair ray was deprojected with
+		InvalidateCrosshairRay();
 	}
 
 	CrosshairSpreadMultiplier = 0.5f +
@@ -477,18 +458,7 @@ void AShooterCharacter::CalculateCrosshairSpread(float DeltaTime)
 
 void AShooterCharacter::StartCrosshairBulletFire()
 {
-	bFiringBullet = true;
-
-	GetWorldTimerManager().SetTimer(
-		CrosshairShootTimer, 
-		this, 
-		&AShooterCharacter::FinishCrosshairBulletFire, 
-		ShootTimeDuration);
-}
-
-void AShooterCharacter::FinishCrosshairBulletFire()
-{
-	bFiringBullet = false;
+	Cooldowns->StartCooldown(CrosshairShootCooldown, ShootTimeDuration);
 }
 
 void AShooterCharacter::FireButtonPressed()
@@ -503,164 +473,113 @@ void AShooterCharacter::FireButtonReleased()
 
 }
 
-void AShooterCharacter::StartFireTimer()
+void AShooterCharacter::StartFireTimer(double FireTime)
 {
 	CombatState = ECombatState::ECS_FireTimerInProgress;
-
-	GetWorldTimerManager().SetTimer(
-		AutoFireTimer,
-		this,
-		&AShooterCharacter::AutoFireReset,
-		EquippedWeapon->GetAutoFireRate());
-	
+	FireScheduler.Start(FireTime, EquippedWeapon->GetAutoFireRate());
 }
 
-void AShooterCharacter::AutoFireReset()
+void AShooterCharacter::UpdateAutoFire()
 {
-	if (CombatState == ECombatState::ECS_Stunned) return;
+	if (!FireScheduler.IsActive()) return;
 
-	CombatState = ECombatState::ECS_Unoccupied;
+	// Stunned (or otherwise interrupted) since the last shot
+	if (CombatState != ECombatState::ECS_FireTimerInProgress)
+	{
+		FireScheduler.Stop();
+		return;
+	}
 
-	if (EquippedWeapon == nullptr) return;
-	if (WeaponHasAmmo())
+	const double Now{ GetWorld()->GetTimeSeconds() };
+	if (!FireScheduler.IsShotDue(Now)) return;
+
+	if (EquippedWeapon && WeaponHasAmmo() && bFireButtonPressed && EquippedWeapon->GetAutomatic())
 	{
-		if (bFireButtonPressed && EquippedWeapon->GetAutomatic())
-		{
-			FireWeapon();
-		}
+		FireScheduledShots(Now);
+		return;
 	}
-	else
+
+	FireScheduler.Stop();
+	CombatState = ECombatState::ECS_Unoccupied;
+
+	if (EquippedWeapon && !WeaponHasAmmo())
 	{
 		// Reload Weapon
 		ReloadWeapon();
 	}
-
 }
 
-bool AShooterCharacter::TraceUnderCrosshairs(FHitResult &OutHitResult,FVector& OutHitLocation)
+void AShooterCharacter::FireScheduledShots(double Now)
 {
-	//Get Viewport size
-	FVector2D ViewportSize;
-	if (GEngine && GEngine->GameViewport)
-	{
-		GEngine->GameViewport->GetViewportSize(ViewportSize);
-	}
+	TArray<double, TInlineAllocator<8>> ShotTimes;
+	FireScheduler.ConsumeShots(Now, ShotTimes);
 
-	// Get Screen space location of crosshairs
-	FVector2D CrosshairLocation(ViewportSize.X/ 2.f,ViewportSize.Y/ 2.f);
-	FVector CrosshairWorldPosition;
-	FVector CrosshairWorldDirection;
+	FTransform MuzzleTransform;
+	const bool bHasMuzzle{ GetBarrelSocketTransform(MuzzleTransform) };
+	const double BlendDuration{ Now - LastMuzzleTime };
 
-	// Get world posiition and direction of crosshairs
-	bool bScreenToWorld = UGameplayStatics::DeprojectScreenToWorld(
-		UGameplayStatics::GetPlayerController(this, 0),
-		CrosshairLocation,
-		CrosshairWorldPosition,
-		CrosshairWorldDirection);
-
-	if(bScreenToWorld)
-	{
-		//Trace from crosshair world location outward
-		const FVector Start{ CrosshairWorldPosition};
-		const FVector End{Start + CrosshairWorldDirection * 50'000.f};
-		OutHitLocation = End;
-		GetWorld()->LineTraceSingleByChannel(
-			OutHitResult,
-			Start,
-			End,
-			ECollisionChannel::ECC_Visibility);
-		if (OutHitResult.bBlockingHit)
+	for (int32 i = 0; i < ShotTimes.Num() && WeaponHasAmmo(); i++)
+	{
+		if (bHasMuzzle)
 		{
-			OutHitLocation = OutHitResult.Location;
-			return true;
+			// Where the barrel was when this shot was due, between last shot and now
+			const float Alpha{ BlendDuration > 0.0 ? FMath::Clamp(static_cast<float>((ShotTimes[i] - LastMuzzleTime) / BlendDuration), 0.f, 1.f) : 1.f };
+			FTransform ShotTransform;
+			ShotTransform.Blend(LastMuzzleTransform, MuzzleTransform, Alpha);
+			SendBullet(ShotTransform, i == ShotTimes.Num() - 1);
 		}
+		EquippedWeapon->DecrementAmmo();
 	}
-    return false;
-}
-
-void AShooterCharacter::TraceForItems()
-{
-	if(bShouldTraceForItems)
+	if (bHasMuzzle)
 	{
-		FHitResult ItemTraceResult;
-		FVector HitLocation;
-		TraceUnderCrosshairs(ItemTraceResult, HitLocation);
-		if (ItemTraceResult.bBlockingHit)
-		{
-			TraceHitItem = Cast<AItem>(ItemTraceResult.GetActor());
-			const auto TraceHitWeapon = Cast<AWeapon>(TraceHitItem);
-			if (TraceHitWeapon)
-			{
-				if (HighlightedSlot == -1)
-				{
-					//Not currently highlighting slot; highlight one
-					HighlightInventorySlot();
-				}
-			}
-			else
-			{
-				//Is a slot being highlight?
-				if (HighlightedSlot != -1)
-				{
-					//Unhighlight the slot
-					UnHighlightInventorySlot();
-				}
-			}
-
-			if (TraceHitItem && TraceHitItem->GetItemState() == EItemState::EIS_EquipInterping)
-			{
-				TraceHitItem = nullptr;
-			}
-
-			if(TraceHitItem && TraceHitItem->GetPickupWidget())
-			{
-				//Show Item's pickup widget
-				TraceHitItem->GetPickupWidget()->SetVisibility(true);
-				TraceHitItem->EnableCustomDepth();
-
-				if (Inventory.Num() >= INVENTORY_CAPACITY)
-				{
-					// Inventory is full
-					TraceHitItem->SetCharacterInventoryFull(true);
-				}
-				else
-				{
-					// Inventory has room
-					TraceHitItem->SetCharacterInventoryFull(false);
-				}
-			}
-
-			//We hit an AItem last frame
-			if(TraceHitItemLastFrame)
-			{
-				if(TraceHitItem != TraceHitItemLastFrame)
-				{
-					// We are hittin a dfferent AItem this frame from last frme
-					// or null
-					TraceHitItemLastFrame->GetPickupWidget()->SetVisibility(false);
-					TraceHitItemLastFrame->DisableCustomDepth();
-				}
-			}
-
-			//Store a reference to HitItem for next frame
-			TraceHitItemLastFrame = TraceHitItem;
-
-		}
+		LastMuzzleTransform = MuzzleTransform;
+		LastMuzzleTime = Now;
 	}
-	else if(TraceHitItemLastFrame)
+
+	// Sound, recoil and crosshair kick once for the whole batch
+	PlayFireSound();
+	PlayGunFireMontage();
+	StartCrosshairBulletFire();
+
+	if (EquippedWeapon->GetWeaponType() == EWeaponType::EWT_Pistol)
 	{
-		// no longer overlapping any items
-		// Item last frame should not shown widget
-		TraceHitItemLastFrame->GetPickupWidget()->SetVisibility(false);
-		TraceHitItemLastFrame->DisableCustomDepth();
+		EquippedWeapon->StartSlideTimer();
 	}
 }
 
+bool AShooterCharacter::GetCrosshairRay(FVector& OutStart, FVector& OutEnd)
+{
+	return CrosshairRayCache.GetRay(
+		UGameplayStatics::GetPlayerController(this, 0),
+		OutStart,
+		OutEnd);
+}
+
+bool AShooterCharacter::TraceUnderCrosshairs(FHitResult &OutHitResult,FVector& OutHitLocation)
+{
+	return CrosshairRayCache.GetHit(
+		UGameplayStatics::GetPlayerController(this, 0),
+		OutHitResult,
+		OutHitLocation);
+}
+
 AWeapon* AShooterCharacter::SpawnDefaultWeapon()
 {
 	// Check the TSubclassOf variable
 	if (DefaultWeaponClass)
 	{
+		// Reuse a dormant weapon from the pool if there is one
+		UItemPoolSubsystem* ItemPool{ GetWorld()->GetSubsystem<UItemPoolSubsystem>() };
+		if (ItemPool)
+		{
+			const AWeapon* WeaponDefaults{ DefaultWeaponClass->GetDefaultObject<AWeapon>() };
+			return ItemPool->AcquireWeapon(
+				DefaultWeaponClass,
+				FTransform::Identity,
+				WeaponDefaults->GetItemRarity(),
+				WeaponDefaults->GetWeaponType());
+		}
+
 		//Spawn the weapon
 		return GetWorld()->SpawnActor<AWeapon>(DefaultWeaponClass);
 	}
@@ -714,10 +633,11 @@ void AShooterCharacter::DropWeapon()
 void AShooterCharacter::SelectButtonPressed()
 {
 	if (CombatState != ECombatState::ECS_Unoccupied) return;
-	if (TraceHitItem)
+	AItem* FocusedItem{ ItemFocusComponent->GetFocusedItem() };
+	if (FocusedItem)
 	{
-		TraceHitItem->StartItemCurve(this, true);
-		TraceHitItem = nullptr;
+		FocusedItem->StartItemCurve(this, true);
+		ItemFocusComponent->ClearFocus();
 	}
 }
 
@@ -735,8 +655,7 @@ void AShooterCharacter::SwapWeapon(AWeapon *WeaponToSwap)
 
 	DropWeapon();
 	EquipWeapon(WeaponToSwap, true);
-	TraceHitItem = nullptr;
-	TraceHitItemLastFrame = nullptr;
+	ItemFocusComponent->ClearFocus();
 }
 
 void AShooterCharacter::InitializeAmmoMap()
@@ -754,94 +673,112 @@ bool AShooterCharacter::WeaponHasAmmo()
 
 void AShooterCharacter::PlayFireSound()
 {
-	// Play fire sound
+	// Play fire sound; sustained auto fire must not run its own cue out of voices
 	if (EquippedWeapon->GetFireSound())
 	{
-		UGameplayStatics::PlaySound2D(this, EquippedWeapon->GetFireSound());
+		UShooterAudioSubsystem::PlaySound2D(GetWorld(), EquippedWeapon->GetFireSound(), true);
 	}
 }
 
-void AShooterCharacter::SendBullet()
+bool AShooterCharacter::GetBarrelSocketTransform(FTransform& OutTransform) const
 {
-	// Send bullet
 	const USkeletalMeshSocket* BarrelSocket = EquippedWeapon->GetItemMesh()->GetSocketByName("BarrelSocket");
-	if (BarrelSocket)
+	if (BarrelSocket == nullptr) return false;
+
+	OutTransform = BarrelSocket->GetSocketTransform(EquippedWeapon->GetItemMesh());
+	return true;
+}
+
+void AShooterCharacter::SendBullet(const FTransform& MuzzleTransform, bool bSpawnMuzzleFlash)
+{
+	SHOOTER_SCOPE_CYCLE_COUNTER(SendBullet);
+
+	if(bSpawnMuzzleFlash && EquippedWeapon->GetMuzzleFlash())
+	{
+		UEffectsPoolSubsystem::PlayEffect(GetWorld(), EquippedWeapon->GetMuzzleFlash(), MuzzleTransform);
+	}
+
+	// Line tracing is batched with every other shot this frame
+	FHitscanRequest ShotRequest;
+	ShotRequest.MuzzleTransform = MuzzleTransform;
+	if (!GetCrosshairRay(ShotRequest.CrosshairTraceStart, ShotRequest.CrosshairTraceEnd))
+	{
+		// No crosshair ray; trace straight out of the barrel
+		ShotRequest.CrosshairTraceStart = MuzzleTransform.GetLocation();
+		ShotRequest.CrosshairTraceEnd = ShotRequest.CrosshairTraceStart + MuzzleTransform.GetRotation().GetForwardVector() * FCrosshairRayCache::TraceDistance;
+	}
+	else if (CrosshairRayCache.GetCachedHitLocation(ShotRequest.CrosshairTraceEnd))
+	{
+		// TraceForItems already traced the crosshairs this frame
+		ShotRequest.bCrosshairResolved = true;
+	}
+	ShotRequest.Damage = EquippedWeapon->GetDamage();
+	ShotRequest.HeadShotDamage = EquippedWeapon->GetHeadShotDamage();
+
+	UHitscanSubsystem* HitscanSubsystem = GetWorld()->GetSubsystem<UHitscanSubsystem>();
+	if (HitscanSubsystem)
+	{
+		ShotRequest.OnResolved.BindUObject(this, &AShooterCharacter::OnBulletResolved);
+		HitscanSubsystem->QueueShot(MoveTemp(ShotRequest));
+	}
+	else
+	{
+		// No batching in this world; trace the shot right away
+		FHitscanResult ShotResult;
+		UHitscanSubsystem::GetBeamEndLocation(GetWorld(), ShotRequest, ShotResult);
+		OnBulletResolved(ShotResult);
+	}
+}
+
+void AShooterCharacter::OnBulletResolved(const FHitscanResult& Result)
+{
+	if (!Result.bBeamHit) return;
+
+	const FHitResult& BeamHitResult{ Result.BeamHitResult };
+
+	//Does hit actor implement BulletHitInterface
+	if (BeamHitResult.GetActor())
 	{
-		const FTransform SocketTransform = BarrelSocket->GetSocketTransform(EquippedWeapon->GetItemMesh());
-		if(EquippedWeapon->GetMuzzleFlash())
+		IBulletHitInterface* BulletHitInterface = Cast<IBulletHitInterface>(BeamHitResult.GetActor());
+		if (BulletHitInterface)
 		{
-			UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), EquippedWeapon->GetMuzzleFlash(), SocketTransform);
+			BulletHitInterface->BulletHit_Implementation(BeamHitResult, this, GetController());
 		}
-
-		//Line Tracing
-		FHitResult BeamHitResult;
-		bool bBeamEnd = GetBeamEndLocation(SocketTransform.GetLocation(), BeamHitResult);
-		
-		if(bBeamEnd)
+		AEnemy* HitEnemy = Cast<AEnemy>(BeamHitResult.GetActor());
+		if (HitEnemy)
 		{
-			//Does hit actor implement BulletHitInterface
-			if (BeamHitResult.GetActor())
-			{
-				IBulletHitInterface* BulletHitInterface = Cast<IBulletHitInterface>(BeamHitResult.GetActor());
-				if (BulletHitInterface)
-				{
-					BulletHitInterface->BulletHit_Implementation(BeamHitResult, this, GetController());
-				}
-				AEnemy* HitEnemy = Cast<AEnemy>(BeamHitResult.GetActor());
-				if (HitEnemy)
-				{
-					int32 Damage{};
-					if (BeamHitResult.BoneName.ToString() == HitEnemy->GetHeadBone())
-					{
-						// HeadShot
-						Damage = EquippedWeapon->GetHeadShotDamage();
-						UGameplayStatics::ApplyDamage(
-							BeamHitResult.GetActor(),
-							Damage,
-							GetController(),
-							this, 
-							UDamageType::StaticClass());
-						HitEnemy->ShowHitNumber(Damage, BeamHitResult.Location, true);
-					}
-					else {
-						// BodyShot
-						Damage = EquippedWeapon->GetDamage();
-						UGameplayStatics::ApplyDamage(
-							BeamHitResult.GetActor(),
-							Damage,
-							GetController(),
-							this,
-							UDamageType::StaticClass());
-						HitEnemy->ShowHitNumber(Damage, BeamHitResult.Location, false);
-					}
-					
-				}
-			}
-			else 
-			{
-				//Spawn Default Particles
-				if (ImpactParticles)
-				{
-					UGameplayStatics::SpawnEmitterAtLocation(
-						GetWorld(),
-						ImpactParticles,
-						BeamHitResult.Location);
-				}
-			}
-
-			if (BeamParticles)
-			{
-				UParticleSystemComponent* Beam = UGameplayStatics::SpawnEmitterAtLocation(
-					GetWorld(),
-					BeamParticles,
-					SocketTransform);
-				if(Beam)
-				{
-					Beam->SetVectorParameter(FName("Target"), BeamHitResult.Location);
-				}
-			}
+			// Applied with the rest of this frame's hits by the damage pipeline
+			FDamageRecord DamageRecord;
+			DamageRecord.Target = HitEnemy;
+			DamageRecord.EventInstigator = GetController();
+			DamageRecord.DamageCauser = this;
+			DamageRecord.HitLocation = BeamHitResult.Location;
+			DamageRecord.bHeadShot = BeamHitResult.BoneName.ToString() == HitEnemy->GetHeadBone();
+			DamageRecord.Damage = DamageRecord.bHeadShot ? Result.HeadShotDamage : Result.Damage;
+			DamageRecord.bShowHitNumber = true;
+			UDamagePipelineSubsystem::QueueDamage(MoveTemp(DamageRecord), GetWorld());
 		}
 	}
+	else 
+	{
+		//Spawn Default Particles
+		if (ImpactParticles)
+		{
+			UEffectsPoolSubsystem::PlayEffect(
+				GetWorld(),
+				ImpactParticles,
+				FTransform(BeamHitResult.Location));
+		}
+	}
+
+	if (BeamParticles)
+	{
+		UEffectsPoolSubsystem::PlayBeam(
+			GetWorld(),
+			BeamParticles,
+			Result.MuzzleTransform,
+			BeamHitResult.Location);
+	}
 }
 	
 void AShooterCharacter::PlayGunFireMontage()
@@ -961,7 +898,8 @@ void AShooterCharacter::InterpCapsuleHalfHeight(float DeltaTime)
 	{
 		TargetCapsuleHalfHeight = StandingCapsuleHalfHeight;
 	}
-	const float InterpHalfHeight{ FMath::FInterpTo(GetCapsuleComponent()->GetScaledCapsuleHalfHeight(), TargetCapsuleHalfHeight, DeltaTime, 20.f )};
+	float InterpHalfHeight{ GetCapsuleComponent()->GetScaledCapsuleHalfHeight() };
+	ShooterInterp::InterpToBatch(MakeArrayView(&InterpHalfHeight, 1), MakeArrayView(&TargetCapsuleHalfHeight, 1), DeltaTime, 20.f);
 	
 	// Negatif value if crouching; Positive value if standing
 	const float DeltaCapsuleHalfHeight{ InterpHalfHeight - GetCapsuleComponent()->GetScaledCapsuleHalfHeight() };
@@ -1140,6 +1078,7 @@ EPhysicalSurface AShooterCharacter::GetSurfaceType()
 	FCollisionQueryParams QueryParams;
 	QueryParams.bReturnPhysicalMaterial = true;
 
+	SHOOTER_COUNT_TRACE();
 	GetWorld()->LineTraceSingleByChannel(HitResult, Start, End, ECollisionChannel::ECC_Visibility, QueryParams);
 	
 	return UPhysicalMaterial::DetermineSurfaceType(HitResult.PhysMaterial.Get());
@@ -1155,6 +1094,16 @@ void AShooterCharacter::EndStun()
 	}
 }
 
+AItem* AShooterCharacter::GetTraceHitItem() const
+{
+	return ItemFocusComponent->GetFocusedItem();
+}
+
+AItem* AShooterCharacter::GetTraceHitItemLastFrame() const
+{
+	return ItemFocusComponent->GetFocusedItem();
+}
+
 void AShooterCharacter::UnHighlightInventorySlot()
 {
 	HighlightIconDelegate.Broadcast(HighlightedSlot, false);
@@ -1195,17 +1144,16 @@ void AShooterCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	// Makes interpolation for zoom when aiming
-	SetSmoothAim(DeltaTime);
-
 	// Change look sensivity based on aiming
 	SetLookRates();
-	//Calculate Crosshair spread multiplier every frame
+	// Fire the automatic shots owed since last frame
+	UpdateAutoFire();
+	//Calculate Crosshair spread multiplier and zoom every frame
 	CalculateCrosshairSpread(DeltaTime);
-	//Check OverlappedItemCount, then trace for items
-	TraceForItems();
 	//Interpolate the capsule height based on crouching/standing
 	InterpCapsuleHalfHeight(DeltaTime);
+	// Find the items we are close enough to pick up
+	UpdateNearbyItems();
 }
 
 // Called to bind functionality to input
@@ -1258,6 +1206,14 @@ void AShooterCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCo
 		&AShooterCharacter::FiveKeyPressed);
 }
 
+void AShooterCharacter::BecomeViewTarget(APlayerController* PC)
+{
+	Super::BecomeViewTarget(PC);
+
+	// Camera cut: the ray cached this frame was deprojected from the previous view
+	InvalidateCrosshairRay();
+}
+
 void AShooterCharacter::FinishReloading()
 {
 	if (CombatState == ECombatState::ECS_Stunned) return;
@@ -1312,34 +1268,49 @@ void AShooterCharacter::FinishEquipping()
 	}
 }
 
-
-void AShooterCharacter::ResetPickupSoundTimer()
-{
-	bShouldPlayPickupSound = true;
-}
-
-void AShooterCharacter::ResetEquipSoundTimer()
-{
-	bShouldPlayEquipSound = true;
-}
-
 float AShooterCharacter::GetCrosshairSpreadMultiplier() const
 {
     return CrosshairSpreadMultiplier;
 }
 
-void AShooterCharacter::IncrementOvelappedItemCount(int8 Amount)
+void AShooterCharacter::UpdateNearbyItems()
 {
-	if (OverlappedItemCount + Amount <= 0)
+	const double Now{ GetWorld()->GetTimeSeconds() };
+	if (Now < NextNearbyItemsQueryTime) return;
+	NextNearbyItemsQueryTime = Now + NearbyItemsQueryInterval;
+
+	const UItemGridSubsystem* ItemGrid{ GetWorld()->GetSubsystem<UItemGridSubsystem>() };
+	if (ItemGrid == nullptr) return;
+
+	const UCapsuleComponent* Capsule{ GetCapsuleComponent() };
+	const FVector CapsuleLocation{ Capsule->GetComponentLocation() };
+	const FVector SegmentOffset{ 0.f, 0.f, Capsule->GetScaledCapsuleHalfHeight_WithoutHemisphere() };
+	QueriedNearbyItems.Reset();
+	ItemGrid->GatherItemsInPickupRange(
+		CapsuleLocation - SegmentOffset,
+		CapsuleLocation + SegmentOffset,
+		Capsule->GetScaledCapsuleRadius(),
+		QueriedNearbyItems);
+
+	// Grid order isn't stable, so compare as sets
+	bool bItemLeft{ false };
+	for (AItem* Item : NearbyItems)
 	{
-		OverlappedItemCount = 0;
-		bShouldTraceForItems = false;
+		if (!QueriedNearbyItems.Contains(Item))
+		{
+			bItemLeft = true;
+			break;
+		}
 	}
-	else
+	if (!bItemLeft && QueriedNearbyItems.Num() == NearbyItems.Num()) return;
+
+	Swap(NearbyItems, QueriedNearbyItems);
+	if (bItemLeft)
 	{
-		OverlappedItemCount += Amount;
-		bShouldTraceForItems = true;
+		UnHighlightInventorySlot();
 	}
+	// Focus component only traces while items are nearby
+	ItemFocusComponent->NotifyNearbyItemsChanged(NearbyItems.Num());
 }
 /* No longer needed; AItem has GetInterpLocation
 FVector AShooterCharacter::GetCameraInterpLocation()
@@ -1364,6 +1335,7 @@ void AShooterCharacter::GetPickupItem(AItem* Item)
 			Weapon->SetSlotIndex(Inventory.Num());
 			Inventory.Add(Weapon);
 			Weapon->SetItemState(EItemState::EIS_PickedUp);
+			ItemFocusComponent->RefreshFocusedItem();
 		}
 		else //Inventory is full! Swap with Equipped Weapon
 		{
@@ -1397,24 +1369,3 @@ void AShooterCharacter::IncrementInterpLocItemCount(int32 Index, int32 Amount)
 		InterpLocations[Index].ItemCount += Amount;
 	}
 }
-
-void AShooterCharacter::StartPickupSoundTimer()
-{
-	bShouldPlayPickupSound = false;
-	GetWorldTimerManager().SetTimer(
-		PickupSoundTimer,
-		this, 
-		&AShooterCharacter::ResetPickupSoundTimer, 
-		PickupSoundResetTime);
-
-}
-
-void AShooterCharacter::StartEquipSoundTimer()
-{
-	bShouldPlayEquipSound = false;
-	GetWorldTimerManager().SetTimer(
-		EquipSoundTimer,
-		this,
-		&AShooterCharacter::ResetEquipSoundTimer,
-		EquipSoundResetTime);
-}
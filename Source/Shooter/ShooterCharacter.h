@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "AmmoType.h"
+#include "CrosshairRayCache.h"
+#include "FireScheduler.h"
 #include "ShooterCharacter.generated.h"
 
 UENUM(BlueprintType)
@@ -57,6 +59,8 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/** Called for forwards/backwards input */
 	void MoveForward(float Value);
 
@@ -91,39 +95,32 @@ protected:
 	/** Called when Fire Button is pressed*/
 	void FireWeapon();
 
-	bool GetBeamEndLocation(const FVector& MuzzleSocketLocation, FHitResult& OutHitResult);
-
 	/** Set bAiming true or false*/
 	void AimingButtonPressed();
 	void AimingButtonReleased();
 
-	/** 
-	 * Using in tick funtion and makes aiming more smooth
-	 * @param DeltaTime classic delta time */
-	void SetSmoothAim(float DeltaTime);
-
 	/** Set BaseTurnRate and BaseLookUpRate based on aiming*/
 	void SetLookRates();
 
+	/** Interp the crosshair spread factors and the zoom field of view toward their targets */
 	void CalculateCrosshairSpread(float DeltaTime);
 
 	void StartCrosshairBulletFire();
-
-	void FinishCrosshairBulletFire();
 	
 	void FireButtonPressed();
 	void FireButtonReleased();
 
-	void StartFireTimer();
+	/** Start the fire rate clock after a shot fired at FireTime */
+	void StartFireTimer(double FireTime);
 
-	UFUNCTION()
-	void AutoFireReset();
+	/** Once the fire rate clock elapses, fire the shots owed while the trigger is held, or stop firing */
+	void UpdateAutoFire();
 
-	/** Line trace for items under the crosshairs*/
-	bool TraceUnderCrosshairs(FHitResult& OutHitResult, FVector& OutHitLocation);
-	
-	/** Trace for items if OverlappedItemCount > 0*/
-	void TraceForItems();
+	/** Fire every shot owed this frame, each from the muzzle position at its own timestamp */
+	void FireScheduledShots(double Now);
+
+	/** World space ray through the center of the screen, served from CrosshairRayCache*/
+	bool GetCrosshairRay(FVector& OutStart, FVector& OutEnd);
 
 	/** Spawns a default weapon and equips it */
 	class AWeapon* SpawnDefaultWeapon();
@@ -148,7 +145,14 @@ protected:
 
 	/** FireWeapon funcitons*/
 	void PlayFireSound();
-	void SendBullet();
+	void SendBullet(const FTransform& MuzzleTransform, bool bSpawnMuzzleFlash);
+
+	/** World transform of the equipped weapon's BarrelSocket; false if there isn't one */
+	bool GetBarrelSocketTransform(FTransform& OutTransform) const;
+
+	/** Called by the hitscan subsystem once the shot from SendBullet has been traced*/
+	void OnBulletResolved(const struct FHitscanResult& Result);
+
 	void PlayGunFireMontage();
 
 	/** Bound R key or Gamepad Face left button*/
@@ -175,6 +179,9 @@ protected:
 	/** Interp capsule half height when crouching/standing */
 	void InterpCapsuleHalfHeight(float DeltaTime);
 
+	/** Ask UItemGridSubsystem for the pickup items in range, every NearbyItemsQueryInterval*/
+	void UpdateNearbyItems();
+
 	void Aim();
 	void StopAiming();
 
@@ -193,8 +200,6 @@ protected:
 
 	int32 GetEmptyInventorySlot();
 
-	void HighlightInventorySlot();
-
 	UFUNCTION(BlueprintCallable)
 	EPhysicalSurface GetSurfaceType();
 
@@ -216,6 +221,9 @@ public:
 	// Called to bind functionality to input
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
+	// Called when a player controller cuts its camera to this character
+	virtual void BecomeViewTarget(APlayerController* PC) override;
+
 
 private:
 
@@ -318,27 +326,46 @@ private:
 	float CrosshairShootingFactor;
 	
 	float ShootTimeDuration;
-	bool bFiringBullet;
-	FTimerHandle CrosshairShootTimer;
+
+	/** Slot in Cooldowns; running for ShootTimeDuration after each shot*/
+	int32 CrosshairShootCooldown;
 
 	/** Left mouse button or right console trigger pressed*/
 	bool bFireButtonPressed;
 
-	/** True when we can fire. False when waitng for the timer*/
-	bool bShouldFire;
+	/** Fire rate clock between gunshots, advanced in Tick*/
+	FFireScheduler FireScheduler;
+
+	/** Barrel transform when the last shot was fired, to place the shots owed in between*/
+	FTransform LastMuzzleTransform;
+
+	/** World time LastMuzzleTransform was sampled at*/
+	double LastMuzzleTime{ 0.0 };
+
+	/** Crosshair deprojection and hit, shared by everything that traces from the crosshairs this frame*/
+	FCrosshairRayCache CrosshairRayCache;
 
-	/** Sets a timer between gunshots*/
-	FTimerHandle AutoFireTimer;
+	/** Pickup items whose pickup radius reaches us, as of the last query*/
+	UPROPERTY()
+	TArray<class AItem*> NearbyItems;
 
-	/** True if we should trace every fram for tems*/
-	bool bShouldTraceForItems;
+	/** Scratch for UpdateNearbyItems*/
+	TArray<AItem*> QueriedNearbyItems;
 
-	/** Number of overlapped AItems*/
-	int8 OverlappedItemCount;
+	/** Seconds between nearby item queries*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Items, meta = (AllowPrivateAccess = true))
+	float NearbyItemsQueryInterval;
+
+	/** World time of the next nearby item query*/
+	double NextNearbyItemsQueryTime;
 
-	/**  The AItem we hit last frame*/
+	/** Traces for the item under the crosshairs while we overlap items*/
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Items, meta = (AllowPrivateAccess = true))
-	class AItem* TraceHitItemLastFrame;
+	class UItemFocusComponent* ItemFocusComponent;
+
+	/** Short-lived states that only need an expiry time*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = true))
+	class UCooldownComponent* Cooldowns;
 
 	/** Currently equpped Weapon*/
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = true))
@@ -348,10 +375,6 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = true))
 	TSubclassOf<AWeapon> DefaultWeaponClass;
 
-	/** The item  currently hit  by our TraceForItems() (could be null)*/
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = true))
-	AItem* TraceHitItem;
-
 	/** Distance outward from the camera for the interp destination*/
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Items, meta = (AllowPrivateAccess = true))
 	float CameraInterpDistance;
@@ -457,15 +480,6 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
 	TArray<FInterpLocation> InterpLocations;
 
-	FTimerHandle PickupSoundTimer;
-	FTimerHandle EquipSoundTimer;
-
-	bool bShouldPlayPickupSound;
-	bool bShouldPlayEquipSound;
-
-	void ResetPickupSoundTimer();
-	void ResetEquipSoundTimer();
-
 	/** Time to wait before we vcan play another Pickup Sound*/
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Items, meta = (AllowPrivateAccess = true))
 	float PickupSoundResetTime;
@@ -476,7 +490,7 @@ private:
 
 	/** An Array of AItems for our Inventory*/
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Inventory, meta = (AllowPrivateAccess = true))
-	TArray<AItem*> Inventory;
+	TArray<class AItem*> Inventory;
 
 	const int32 INVENTORY_CAPACITY{ 6 };
 
@@ -536,10 +550,7 @@ public:
 	UFUNCTION(BlueprintCallable)
 	float GetCrosshairSpreadMultiplier() const;
 
-	FORCEINLINE int8 GetOverlappedItemCount() const{ return OverlappedItemCount;}
-
-	/** Add/subtracts to/from OverlappedItemCount and updates bShouldTraceForItems*/
-	void IncrementOvelappedItemCount(int8 Amount);
+	FORCEINLINE int32 GetNearbyItemCount() const { return NearbyItems.Num(); }
 
 	// No longer needed; AItem has GetInterpLocation
 	//FVector GetCameraInterpLocation();
@@ -556,13 +567,20 @@ public:
 
 	void IncrementInterpLocItemCount(int32 Index, int32 Amount);
 
-	FORCEINLINE bool ShouldPlayPickupSound() const { return bShouldPlayPickupSound; }
-	FORCEINLINE bool ShouldPlayEquipSound() const { return bShouldPlayEquipSound; }
-
-	void StartPickupSoundTimer();
-	void StartEquipSoundTimer();
+	FORCEINLINE float GetPickupSoundResetTime() const { return PickupSoundResetTime; }
+	FORCEINLINE float GetEquipSoundResetTime() const { return EquipSoundResetTime; }
 
+	void HighlightInventorySlot();
 	void UnHighlightInventorySlot();
+	FORCEINLINE int32 GetHighlightedSlot() const { return HighlightedSlot; }
+
+	FORCEINLINE bool IsInventoryFull() const { return Inventory.Num() >= INVENTORY_CAPACITY; }
+
+	/** Line trace for items under the crosshairs*/
+	bool TraceUnderCrosshairs(FHitResult& OutHitResult, FVector& OutHitLocation);
+
+	/** Drop the cached crosshair ray; called on camera cuts and zoom changes*/
+	FORCEINLINE void InvalidateCrosshairRay() { CrosshairRayCache.Invalidate(); }
 
 	FORCEINLINE AWeapon* GetEquippedWeapon() const { return EquippedWeapon; }
 	FORCEINLINE USoundCue* GetMeleeImpactSound() const { return MeleeImpactSound; }
@@ -570,4 +588,13 @@ public:
 
 	void Stun();
 	FORCEINLINE float GetStunChance() const { return StunChance; }
+	FORCEINLINE bool IsDead() const { return bDead; }
+
+	/** The item currently under the crosshairs (could be null), for Blueprints that read TraceHitItem*/
+	UFUNCTION(BlueprintPure, Category = Items)
+	class AItem* GetTraceHitItem() const;
+
+	/** Same as GetTraceHitItem: the focused item is only updated when it changes, so there is no separate last frame item*/
+	UFUNCTION(BlueprintPure, Category = Items)
+	class AItem* GetTraceHitItemLastFrame() const;
 };
@@ -0,0 +1,10 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ShooterCounters.h"
+
+namespace ShooterCounters
+{
+	std::atomic<uint64> NumTraces{ 0 };
+	std::atomic<uint64> NumDamageEvents{ 0 };
+}
@@ -0,0 +1,19 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Running totals of gameplay work, cheap enough to always be on.
+ * UShooterBenchmarkCommandlet samples them to report rates.
+ */
+namespace ShooterCounters
+{
+	/** Line traces issued by weapon fire, the crosshair and footsteps */
+	extern SHOOTER_API std::atomic<uint64> NumTraces;
+
+	/** TakeDamage calls on characters and enemies */
+	extern SHOOTER_API std::atomic<uint64> NumDamageEvents;
+}
@@ -0,0 +1,139 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ShooterDataTableCache.h"
+#include "Engine/DataTable.h"
+#include "Item.h"
+#include "Weapon.h"
+
+namespace
+{
+	const TCHAR* RarityTablePath{ TEXT("/Script/Engine.DataTable'/Game/_Game/DataTable/ItemRarityDataTable.ItemRarityDataTable'") };
+	const TCHAR* WeaponTablePath{ TEXT("/Script/Engine.DataTable'/Game/_Game/DataTable/WeaponDataTable.WeaponDataTable'") };
+
+	/** Row names in EItemRarity order */
+	const TCHAR* RarityRowNames[]{ TEXT("Damaged"), TEXT("Common"), TEXT("Uncommon"), TEXT("Rare"), TEXT("Legendary") };
+	static_assert(UE_ARRAY_COUNT(RarityRowNames) == static_cast<int32>(EItemRarity::EIR_MAX), "RarityRowNames must match EItemRarity");
+
+	/** Row names in EWeaponType order */
+	const TCHAR* WeaponRowNames[]{ TEXT("SubmachineGun"), TEXT("AssaultRifle"), TEXT("Pistol") };
+	static_assert(UE_ARRAY_COUNT(WeaponRowNames) == static_cast<int32>(EWeaponType::EWT_MAX), "WeaponRowNames must match EWeaponType");
+}
+
+TUniquePtr<FShooterDataTableCache> FShooterDataTableCache::Instance;
+
+FShooterDataTableCache& FShooterDataTableCache::Get()
+{
+	check(IsInGameThread());
+	if (!Instance.IsValid())
+	{
+		Instance = TUniquePtr<FShooterDataTableCache>(new FShooterDataTableCache());
+	}
+	return *Instance;
+}
+
+void FShooterDataTableCache::Shutdown()
+{
+	Instance.Reset();
+}
+
+FShooterDataTableCache::FShooterDataTableCache() :
+	RarityTable(nullptr),
+	WeaponTable(nullptr),
+	bRowsResolved(false)
+{
+}
+
+FShooterDataTableCache::~FShooterDataTableCache()
+{
+	if (UObjectInitialized())
+	{
+		if (RarityTable)
+		{
+			RarityTable->OnDataTableChanged().RemoveAll(this);
+		}
+		if (WeaponTable)
+		{
+			WeaponTable->OnDataTableChanged().RemoveAll(this);
+		}
+	}
+}
+
+const FItemRarityTable* FShooterDataTableCache::GetRarityRow(EItemRarity Rarity)
+{
+	if (!bRowsResolved)
+	{
+		ResolveRows();
+	}
+	const int32 Index{ static_cast<int32>(Rarity) };
+	return RarityRows.IsValidIndex(Index) ? RarityRows[Index] : nullptr;
+}
+
+const FWeaponDataTable* FShooterDataTableCache::GetWeaponRow(EWeaponType WeaponType)
+{
+	if (!bRowsResolved)
+	{
+		ResolveRows();
+	}
+	const int32 Index{ static_cast<int32>(WeaponType) };
+	return WeaponRows.IsValidIndex(Index) ? WeaponRows[Index] : nullptr;
+}
+
+void FShooterDataTableCache::Invalidate()
+{
+	bRowsResolved = false;
+}
+
+void FShooterDataTableCache::ResolveRows()
+{
+	check(IsInGameThread());
+
+	if (RarityTable == nullptr)
+	{
+		RarityTable = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, RarityTablePath));
+		if (RarityTable)
+		{
+			// Reimporting or editing the table reallocates its rows
+			RarityTable->OnDataTableChanged().AddRaw(this, &FShooterDataTableCache::Invalidate);
+		}
+	}
+	if (WeaponTable == nullptr)
+	{
+		WeaponTable = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, WeaponTablePath));
+		if (WeaponTable)
+		{
+			WeaponTable->OnDataTableChanged().AddRaw(this, &FShooterDataTableCache::Invalidate);
+		}
+	}
+
+	RarityRows.Init(nullptr, UE_ARRAY_COUNT(RarityRowNames));
+	if (RarityTable)
+	{
+		for (int32 i = 0; i < RarityRows.Num(); i++)
+		{
+			RarityRows[i] = RarityTable->FindRow<FItemRarityTable>(FName(RarityRowNames[i]), TEXT(""));
+		}
+	}
+
+	WeaponRows.Init(nullptr, UE_ARRAY_COUNT(WeaponRowNames));
+	if (WeaponTable)
+	{
+		for (int32 i = 0; i < WeaponRows.Num(); i++)
+		{
+			WeaponRows[i] = WeaponTable->FindRow<FWeaponDataTable>(FName(WeaponRowNames[i]), TEXT(""));
+		}
+	}
+
+	bRowsResolved = true;
+}
+
+void FShooterDataTableCache::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObject(RarityTable);
+	Collector.AddReferencedObject(WeaponTable);
+}
+
+FString FShooterDataTableCache::GetReferencerName() const
+{
+	return TEXT("FShooterDataTableCache");
+}
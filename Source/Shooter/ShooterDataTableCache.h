@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+
+class UDataTable;
+struct FItemRarityTable;
+struct FWeaponDataTable;
+enum class EItemRarity : uint8;
+enum class EWeaponType : uint8;
+
+/**
+ * Module-wide cache of the item rarity and weapon data tables.
+ * Created on first use and destroyed by the Shooter module on shutdown.
+ * The tables are loaded once and their rows resolved into arrays indexed by enum value,
+ * so construction scripts don't load objects or look up rows by name.
+ * The rows are resolved again after a table is reimported or edited.
+ */
+class SHOOTER_API FShooterDataTableCache : public FGCObject
+{
+public:
+	static FShooterDataTableCache& Get();
+
+	/** Destroy the cache; called from the module's ShutdownModule */
+	static void Shutdown();
+
+	virtual ~FShooterDataTableCache();
+
+	/** Row for the rarity, or null if the table or the row is missing */
+	const FItemRarityTable* GetRarityRow(EItemRarity Rarity);
+
+	/** Row for the weapon type, or null if the table or the row is missing */
+	const FWeaponDataTable* GetWeaponRow(EWeaponType WeaponType);
+
+	/** Drop the resolved rows; they are resolved again on next use */
+	void Invalidate();
+
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override;
+
+private:
+	FShooterDataTableCache();
+
+	/** Load the tables if needed and fill the row arrays */
+	void ResolveRows();
+
+	UDataTable* RarityTable;
+	UDataTable* WeaponTable;
+
+	/** Indexed by EItemRarity */
+	TArray<const FItemRarityTable*> RarityRows;
+
+	/** Indexed by EWeaponType */
+	TArray<const FWeaponDataTable*> WeaponRows;
+
+	bool bRowsResolved;
+
+	static TUniquePtr<FShooterDataTableCache> Instance;
+};
@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ShooterInterp.h"
+
+VectorRegister4Float ShooterInterp::InterpTo4(const VectorRegister4Float& Current, const VectorRegister4Float& Target, float DeltaTime, const VectorRegister4Float& InterpSpeed)
+{
+	const VectorRegister4Float Zero{ VectorZeroFloat() };
+	const VectorRegister4Float Dist{ VectorSubtract(Target, Current) };
+	const VectorRegister4Float Alpha{ VectorMin(VectorMax(VectorMultiply(VectorSetFloat1(DeltaTime), InterpSpeed), Zero), VectorOneFloat()) };
+	const VectorRegister4Float Result{ VectorMultiplyAdd(Dist, Alpha, Current) };
+
+	// Like FInterpTo, snap to the target when the speed isn't positive or the target is reached
+	const VectorRegister4Float SnapMask{ VectorBitwiseOr(
+		VectorCompareLE(InterpSpeed, Zero),
+		VectorCompareLT(VectorMultiply(Dist, Dist), VectorSetFloat1(UE_SMALL_NUMBER))) };
+	return VectorSelect(SnapMask, Target, Result);
+}
+
+void ShooterInterp::InterpToBatch(TArrayView<float> Current, TArrayView<const float> Target, float DeltaTime, float InterpSpeed)
+{
+	check(Current.Num() == Target.Num());
+
+	float* CurrentData{ Current.GetData() };
+	const float* TargetData{ Target.GetData() };
+	const VectorRegister4Float Speed{ VectorSetFloat1(InterpSpeed) };
+	const int32 Num{ Current.Num() };
+
+	int32 Index{ 0 };
+	for (; Index + 4 <= Num; Index += 4)
+	{
+		VectorStore(InterpTo4(VectorLoad(CurrentData + Index), VectorLoad(TargetData + Index), DeltaTime, Speed), CurrentData + Index);
+	}
+	for (; Index < Num; Index++)
+	{
+		CurrentData[Index] = FMath::FInterpTo(CurrentData[Index], TargetData[Index], DeltaTime, InterpSpeed);
+	}
+}
@@ -0,0 +1,19 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Exponential smoothing with the same results as FMath::FInterpTo, evaluated four channels
+ * at a time in SIMD lanes. Used for the character's crosshair spread, zoom and capsule
+ * interpolation and, in batches, for every interping item at once.
+ */
+namespace ShooterInterp
+{
+	/** FMath::FInterpTo for four channels, one per lane */
+	VectorRegister4Float InterpTo4(const VectorRegister4Float& Current, const VectorRegister4Float& Target, float DeltaTime, const VectorRegister4Float& InterpSpeed);
+
+	/** Interpolate every channel of Current toward the matching Target in place, all at the same speed */
+	void InterpToBatch(TArrayView<float> Current, TArrayView<const float> Target, float DeltaTime, float InterpSpeed);
+}
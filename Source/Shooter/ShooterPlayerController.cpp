@@ -3,6 +3,7 @@
 
 #include "ShooterPlayerController.h"
 #include "Blueprint/UserWidget.h"
+#include "ShooterStats.h"
 
 AShooterPlayerController::AShooterPlayerController()
 {
@@ -17,6 +18,7 @@ void    AShooterPlayerController::BeginPlay()
         HUDOverlay = CreateWidget<UUserWidget>(this,HUDOverlayClass);
         if (HUDOverlay)
         {
+            SHOOTER_INC_COUNTER(WidgetsCreated);
             HUDOverlay->AddToViewport();
             HUDOverlay->SetVisibility(ESlateVisibility::Visible);   
         }
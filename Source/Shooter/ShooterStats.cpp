@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ShooterStats.h"
+
+DEFINE_STAT(STAT_FireWeapon);
+DEFINE_STAT(STAT_SendBullet);
+DEFINE_STAT(STAT_GetBeamEndLocation);
+DEFINE_STAT(STAT_TraceForItems);
+DEFINE_STAT(STAT_CalculateCrosshairSpread);
+DEFINE_STAT(STAT_ItemInterp);
+DEFINE_STAT(STAT_UpdatePulse);
+DEFINE_STAT(STAT_UpdateHitNumbers);
+DEFINE_STAT(STAT_EnemyTakeDamage);
+DEFINE_STAT(STAT_UpdateAnimationProperties);
+
+DEFINE_STAT(STAT_TracesIssued);
+DEFINE_STAT(STAT_EmittersSpawned);
+DEFINE_STAT(STAT_WidgetsCreated);
+DEFINE_STAT(STAT_BlackboardWrites);
+
+CSV_DEFINE_CATEGORY_MODULE(SHOOTER_API, Shooter, true);
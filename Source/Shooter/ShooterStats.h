@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Shooter.h"
+#include "ShooterCounters.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+/**
+ * Cycle stats and per-frame counters for the gameplay hot paths.
+ * Each one shows up under "stat Shooter" and in Insights, and is also written to the
+ * Shooter category of CSV captures ("CsvProfile Start" in game, -CsvCapture= in the benchmark).
+ */
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FireWeapon"), STAT_FireWeapon, STATGROUP_Shooter, SHOOTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("SendBullet"), STAT_SendBullet, STATGROUP_Shooter, SHOOTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GetBeamEndLocation"), STAT_GetBeamEndLocation, STATGROUP_Shooter, SHOOTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("TraceForItems"), STAT_TraceForItems, STATGROUP_Shooter, SHOOTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CalculateCrosshairSpread"), STAT_CalculateCrosshairSpread, STATGROUP_Shooter, SHOOTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ItemInterp"), STAT_ItemInterp, STATGROUP_Shooter, SHOOTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UpdatePulse"), STAT_UpdatePulse, STATGROUP_Shooter, SHOOTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UpdateHitNumbers"), STAT_UpdateHitNumbers, STATGROUP_Shooter, SHOOTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enemy TakeDamage"), STAT_EnemyTakeDamage, STATGROUP_Shooter, SHOOTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UpdateAnimationProperties"), STAT_UpdateAnimationProperties, STATGROUP_Shooter, SHOOTER_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces issued"), STAT_TracesIssued, STATGROUP_Shooter, SHOOTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Emitters spawned"), STAT_EmittersSpawned, STATGROUP_Shooter, SHOOTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Widgets created"), STAT_WidgetsCreated, STATGROUP_Shooter, SHOOTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Blackboard writes"), STAT_BlackboardWrites, STATGROUP_Shooter, SHOOTER_API);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(SHOOTER_API, Shooter);
+
+/**
+ * Time the enclosing scope as STAT_<Name>, and as <Name> in the Shooter CSV category.
+ * Declares two scoped timers, so it has to sit directly in the block being timed, never as the body of an unbraced if
+ */
+#define SHOOTER_SCOPE_CYCLE_COUNTER(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_##Name); \
+	CSV_SCOPED_TIMING_STAT(Shooter, Name)
+
+/** Add Amount to STAT_<Name> and to this frame's <Name> value in the Shooter CSV category */
+#define SHOOTER_INC_COUNTER_BY(Name, Amount) \
+	do \
+	{ \
+		INC_DWORD_STAT_BY(STAT_##Name, Amount); \
+		CSV_CUSTOM_STAT(Shooter, Name, static_cast<int32>(Amount), ECsvCustomStatOp::Accumulate); \
+	} while (0)
+
+#define SHOOTER_INC_COUNTER(Name) SHOOTER_INC_COUNTER_BY(Name, 1)
+
+/** Count one line trace, in ShooterCounters::NumTraces for the benchmark and in STAT_TracesIssued */
+#define SHOOTER_COUNT_TRACE() \
+	do \
+	{ \
+		ShooterCounters::NumTraces.fetch_add(1, std::memory_order_relaxed); \
+		SHOOTER_INC_COUNTER(TracesIssued); \
+	} while (0)
@@ -0,0 +1,149 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Uniform grid spatial hash of point elements (actors, handles, ...).
+ * Each element is bucketed by the cell containing its location; sphere queries only visit
+ * the cells overlapping the sphere. Moving an element inside its cell costs a map lookup.
+ */
+template<typename ElementType>
+class TSpatialHashGrid
+{
+public:
+	explicit TSpatialHashGrid(float InCellSize = 1'000.f)
+	{
+		SetCellSize(InCellSize);
+	}
+
+	/** Change the cell size; only allowed while the grid is empty */
+	void SetCellSize(float InCellSize)
+	{
+		check(Entries.Num() == 0);
+		CellSize = FMath::Max(InCellSize, 1.f);
+		InvCellSize = 1.f / CellSize;
+	}
+
+	/** Add an element, or move it if it is already in the grid */
+	void Add(ElementType Element, const FVector& Location)
+	{
+		if (FEntry* Entry = Entries.Find(Element))
+		{
+			MoveEntry(Element, *Entry, Location);
+			return;
+		}
+
+		const FIntVector Cell{ GetCell(Location) };
+		Entries.Add(Element, FEntry{ Location, Cell });
+		Cells.FindOrAdd(Cell).Add(Element);
+	}
+
+	void Remove(ElementType Element)
+	{
+		FEntry Entry;
+		if (!Entries.RemoveAndCopyValue(Element, Entry)) return;
+
+		RemoveFromCell(Element, Entry.Cell);
+	}
+
+	/** Move an element that is already in the grid; does nothing otherwise */
+	void Update(ElementType Element, const FVector& Location)
+	{
+		if (FEntry* Entry = Entries.Find(Element))
+		{
+			MoveEntry(Element, *Entry, Location);
+		}
+	}
+
+	bool Contains(ElementType Element) const
+	{
+		return Entries.Contains(Element);
+	}
+
+	/** Append every element whose location is within Radius of Center */
+	template<typename AllocatorType>
+	void QuerySphere(const FVector& Center, float Radius, TArray<ElementType, AllocatorType>& OutElements) const
+	{
+		const FIntVector MinCell{ GetCell(Center - FVector(Radius)) };
+		const FIntVector MaxCell{ GetCell(Center + FVector(Radius)) };
+		const double RadiusSquared{ FMath::Square(static_cast<double>(Radius)) };
+
+		for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+			{
+				for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+				{
+					const FCellElements* CellElements{ Cells.Find(FIntVector(X, Y, Z)) };
+					if (CellElements == nullptr) continue;
+
+					for (const ElementType& Element : *CellElements)
+					{
+						if (FVector::DistSquared(Entries.FindChecked(Element).Location, Center) <= RadiusSquared)
+						{
+							OutElements.Add(Element);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	void Reset()
+	{
+		Entries.Reset();
+		Cells.Reset();
+	}
+
+	FORCEINLINE int32 Num() const { return Entries.Num(); }
+	FORCEINLINE float GetCellSize() const { return CellSize; }
+
+private:
+	struct FEntry
+	{
+		FVector Location;
+		FIntVector Cell;
+	};
+
+	using FCellElements = TArray<ElementType, TInlineAllocator<4>>;
+
+	FIntVector GetCell(const FVector& Location) const
+	{
+		return FIntVector(
+			FMath::FloorToInt(Location.X * InvCellSize),
+			FMath::FloorToInt(Location.Y * InvCellSize),
+			FMath::FloorToInt(Location.Z * InvCellSize));
+	}
+
+	void MoveEntry(ElementType Element, FEntry& Entry, const FVector& Location)
+	{
+		Entry.Location = Location;
+
+		const FIntVector Cell{ GetCell(Location) };
+		if (Cell == Entry.Cell) return;
+
+		RemoveFromCell(Element, Entry.Cell);
+		Cells.FindOrAdd(Cell).Add(Element);
+		Entry.Cell = Cell;
+	}
+
+	void RemoveFromCell(ElementType Element, const FIntVector& Cell)
+	{
+		FCellElements* CellElements{ Cells.Find(Cell) };
+		if (CellElements == nullptr) return;
+
+		CellElements->RemoveSingleSwap(Element, false);
+		if (CellElements->Num() == 0)
+		{
+			Cells.Remove(Cell);
+		}
+	}
+
+	TMap<ElementType, FEntry> Entries;
+	TMap<FIntVector, FCellElements> Cells;
+
+	float CellSize{ 1'000.f };
+	float InvCellSize{ 1.f / 1'000.f };
+};
@@ -2,6 +2,7 @@
 
 
 #include "Weapon.h"
+#include "ShooterDataTableCache.h"
 
 
 AWeapon::AWeapon():
@@ -20,12 +21,17 @@ AWeapon::AWeapon():
     MaxRecoilRotation(20.f),
     bAutomatic(true)
 {
-    PrimaryActorTick.bCanEverTick = true;
 }
 
-void AWeapon::Tick(float DeltaTime)
+bool AWeapon::ShouldTickItem() const
 {
-    Super::Tick(DeltaTime);
+    const bool bKeepUpright{ GetItemState() == EItemState::EIS_Falling && bFalling };
+    return Super::ShouldTickItem() || bKeepUpright || bMovingSlide;
+}
+
+void AWeapon::TickItem(float DeltaTime)
+{
+    Super::TickItem(DeltaTime);
 
     //Keep the Weapon upright
     if(GetItemState() == EItemState::EIS_Falling && bFalling)
@@ -53,6 +59,7 @@ void AWeapon::ThrowWeapon()
     GetItemMesh()->AddImpulse(ImpulseDirection);
     
     bFalling = true;
+    RegisterForItemTick();
     GetWorldTimerManager().SetTimer(
         ThrowWeaponTimer, 
         this, 
@@ -66,73 +73,75 @@ void AWeapon::StopFalling()
 {
     bFalling = false;
     SetItemState(EItemState::EIS_Pickup);
-    StartPulseTimer();
 }
 
-void AWeapon::OnConstruction(const FTransform& Transform)
+void AWeapon::ApplyItemData()
+{
+    Super::ApplyItemData();
+
+    // Weapon rows are loaded and resolved once, not on every construction pass
+    const FWeaponDataTable* WeaponDataRow = FShooterDataTableCache::Get().GetWeaponRow(WeaponType);
+    if (WeaponDataRow)
+    {
+        AmmoType = WeaponDataRow->AmmoType;
+        Ammo = WeaponDataRow->WeaponAmmo;
+        MagazineCapacity = WeaponDataRow->MagazineCapacity;
+        SetPickupSound(WeaponDataRow->PickupSound);
+        SetEquipSound(WeaponDataRow->EquipSound);
+        GetItemMesh()->SetSkeletalMesh(WeaponDataRow->ItemMesh);
+        SetItemName(WeaponDataRow->ItemName);
+        SetIconItem(WeaponDataRow->InventoryIcon);
+        SetAmmoIcon(WeaponDataRow->AmmoIcon);
+
+        SetMaterialInstance(WeaponDataRow->MaterialInstance);
+        PreviousMaterialIndex = GetMaterialIndex();
+        GetItemMesh()->SetMaterial(PreviousMaterialIndex, nullptr);
+        SetMaterialIndex(WeaponDataRow->MaterialIndex);
+        SetClipBoneName(WeaponDataRow->ClipBoneName);
+        SetReloadMontageSection(WeaponDataRow->ReloadMontageSection);
+        GetItemMesh()->SetAnimInstanceClass(WeaponDataRow->AnimBP);
+        CrosshairsMiddle = WeaponDataRow->CrosshairsMiddle;
+        CrosshairsLeft = WeaponDataRow->CrosshairsLeft;
+        CrosshairsRight = WeaponDataRow->CrosshairsRight;
+        CrosshairsTop = WeaponDataRow->CrosshairsTop;
+        CrosshairsBottom = WeaponDataRow->CrosshairsBottom;
+        AutoFireRate = WeaponDataRow->AutoFireRate;
+        MuzzleFlash = WeaponDataRow->MuzzleFlash;
+        FireSound = WeaponDataRow->FireSound;
+        BoneToHide = WeaponDataRow->BoneToHide;
+        bAutomatic = WeaponDataRow->bAutomatic;
+        Damage = WeaponDataRow->Damage;
+        HeadShotDamage = WeaponDataRow->HeadShotDamage;
+    }
+    UpdateDynamicMaterialInstance();
+}
+
+void AWeapon::SetItemProperties(EItemState State)
+{
+    Super::SetItemProperties(State);
+
+    if (State == EItemState::EIS_Dormant)
+    {
+        bFalling = false;
+        bMovingSlide = false;
+        bMovingClip = false;
+        SlideDisplacement = 0.f;
+    }
+}
+
+void AWeapon::RearmWeapon(EItemRarity NewRarity, EWeaponType NewWeaponType)
 {
-    Super::OnConstruction(Transform);
+    if (BoneToHide != FName(""))
+    {
+        GetItemMesh()->UnHideBoneByName(BoneToHide);
+    }
 
-    const FString WeaponTablePath(TEXT("/Script/Engine.DataTable'/Game/_Game/DataTable/WeaponDataTable.WeaponDataTable'"));
-    UDataTable* WeaponTableObject = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, *WeaponTablePath));
+    WeaponType = NewWeaponType;
+    RearmItem(NewRarity);
 
-    if (WeaponTableObject)
+    if (BoneToHide != FName(""))
     {
-        FWeaponDataTable* WeaponDataRow = nullptr;
-        switch (WeaponType)
-        {
-        case EWeaponType::EWT_SubmachineGun:
-            WeaponDataRow = WeaponTableObject->FindRow<FWeaponDataTable>(FName("SubmachineGun"), TEXT(""));
-            break;
-
-        case EWeaponType::EWT_AssaultRifle:
-            WeaponDataRow = WeaponTableObject->FindRow<FWeaponDataTable>(FName("AssaultRifle"), TEXT(""));
-            break;
-        case EWeaponType::EWT_Pistol:
-            WeaponDataRow = WeaponTableObject->FindRow<FWeaponDataTable>(FName("Pistol"), TEXT(""));
-            break;
-        }
-        if (WeaponDataRow)
-        {
-            AmmoType = WeaponDataRow->AmmoType;
-            Ammo = WeaponDataRow->WeaponAmmo;
-            MagazineCapacity = WeaponDataRow->MagazineCapacity;
-            SetPickupSound(WeaponDataRow->PickupSound);
-            SetEquipSound(WeaponDataRow->EquipSound);
-            GetItemMesh()->SetSkeletalMesh(WeaponDataRow->ItemMesh);
-            SetItemName(WeaponDataRow->ItemName);
-            SetIconItem(WeaponDataRow->InventoryIcon);
-            SetAmmoIcon(WeaponDataRow->AmmoIcon);
-
-            SetMaterialInstance(WeaponDataRow->MaterialInstance);
-            PreviousMaterialIndex = GetMaterialIndex();
-            GetItemMesh()->SetMaterial(PreviousMaterialIndex, nullptr);
-            SetMaterialIndex(WeaponDataRow->MaterialIndex);
-            SetClipBoneName(WeaponDataRow->ClipBoneName);
-            SetReloadMontageSection(WeaponDataRow->ReloadMontageSection);
-            GetItemMesh()->SetAnimInstanceClass(WeaponDataRow->AnimBP);
-            CrosshairsMiddle = WeaponDataRow->CrosshairsMiddle;
-            CrosshairsLeft = WeaponDataRow->CrosshairsLeft;
-            CrosshairsRight = WeaponDataRow->CrosshairsRight;
-            CrosshairsTop = WeaponDataRow->CrosshairsTop;
-            CrosshairsBottom = WeaponDataRow->CrosshairsBottom;
-            AutoFireRate = WeaponDataRow->AutoFireRate;
-            MuzzleFlash = WeaponDataRow->MuzzleFlash;
-            FireSound = WeaponDataRow->FireSound;
-            BoneToHide = WeaponDataRow->BoneToHide;
-            bAutomatic = WeaponDataRow->bAutomatic;
-            Damage = WeaponDataRow->Damage;
-            HeadShotDamage = WeaponDataRow->HeadShotDamage;
-
-        }
-        if (GetMaterialInstance())
-        {
-            SetDynamicMaterialInstance( UMaterialInstanceDynamic::Create(GetMaterialInstance(), this));
-            GetDynamicMaterialInstance()->SetVectorParameterValue(TEXT("FresnelColor"), GetGlowColor());
-            GetItemMesh()->SetMaterial(GetMaterialIndex(), GetDynamicMaterialInstance());
-
-            EnableGlowMaterial();
-        }
+        GetItemMesh()->HideBoneByName(BoneToHide, EPhysBodyOp::PBO_None);
     }
 }
 
@@ -175,6 +184,7 @@ void AWeapon::DecrementAmmo()
 void AWeapon::StartSlideTimer()
 {
     bMovingSlide = true;
+    RegisterForItemTick();
     GetWorldTimerManager().SetTimer(
         SlideTimer,
         this,
@@ -102,12 +102,18 @@ class SHOOTER_API AWeapon : public AItem
 public:
 	AWeapon();
 
-	virtual void Tick(float DeltaTime) override;
+	virtual bool ShouldTickItem() const override;
+	virtual void TickItem(float DeltaTime) override;
+
+	/** Give a pooled weapon a new rarity and weapon type without spawning a new actor*/
+	void RearmWeapon(EItemRarity NewRarity, EWeaponType NewWeaponType);
 
 protected:
 	void StopFalling();
 
-	virtual void OnConstruction(const FTransform& Transform) override;
+	virtual void ApplyItemData() override;
+
+	virtual void SetItemProperties(EItemState State) override;
 	
 	virtual void BeginPlay() override;
 